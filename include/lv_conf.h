@@ -23,8 +23,14 @@
    COLOR SETTINGS
  *====================*/
 
-/*Color depth: 1 (1 byte per pixel), 8 (RGB332), 16 (RGB565), 32 (ARGB8888)*/
+/*Color depth: 1 (1 byte per pixel), 8 (RGB332), 16 (RGB565), 32 (ARGB8888)
+ *-D ROVI_COLOR_DEPTH_8=1 renders RGB332 (half the draw buffer RAM); WsLcd35S3Hal expands it
+ *to RGB565 through a lookup table while flushing.*/
+#if defined(ROVI_COLOR_DEPTH_8) && ROVI_COLOR_DEPTH_8
+#define LV_COLOR_DEPTH 8
+#else
 #define LV_COLOR_DEPTH 16
+#endif
 
 /*Swap the 2 bytes of RGB565 color. Useful if the display has an 8-bit interface (e.g. SPI)*/
 #define LV_COLOR_16_SWAP 0
@@ -77,10 +83,11 @@
    HAL SETTINGS
  *====================*/
 
-/*Default display refresh period. LVG will redraw changed areas with this period time*/
+/*Default display refresh period. LVG will redraw changed areas with this period time
+ *(the "active" rate; WsLcd35S3Hal slows down / speeds up from here, see ROVI_ADAPTIVE_RATES)*/
 #define LV_DISP_DEF_REFR_PERIOD 30      /*[ms]*/
 
-/*Input device read period in milliseconds*/
+/*Input device read period in milliseconds (also adapted at runtime by WsLcd35S3Hal)*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
 /*Use a custom tick source that tells the elapsed time in milliseconds.
@@ -702,7 +709,7 @@
  *----------*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
@@ -0,0 +1,405 @@
+#include "EventScanner.h"
+
+namespace live_dashboard {
+
+static bool is_ws_(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+static bool key_is_(const char *key, size_t len, const char *want) {
+  for (size_t i = 0; i < len; ++i) {
+    if (want[i] != key[i]) return false;
+  }
+  return want[len] == '\0';
+}
+
+void EventScanner::begin(Sink sink, void *user) {
+  sink_ = sink;
+  user_ = user;
+  status_ = Status::kNeedMore;
+  state_ = State::kRoot;
+  field_ = Field::kNone;
+  context_ = Context::kObject;
+  root_array_ = false;
+  snapshot_ = false;
+  snapshot_accepted_ = false;
+  snapshot_index_ = 0;
+  dispatched_ = 0;
+  applied_ = 0;
+  key_len_ = 0;
+  has_cfg_ = false;
+  cfg_len_ = 0;
+}
+
+bool EventScanner::fail_() {
+  status_ = Status::kUnsupported;
+  return true;
+}
+
+void EventScanner::startObject_() {
+  id_len_ = 0;
+  has_id_ = false;
+  startElement_();
+  state_ = State::kObjFirst;
+}
+
+void EventScanner::startElement_() {
+  text_len_ = 0;
+  has_text_ = false;
+  has_value_ = false;
+  value_ = 0;
+}
+
+bool EventScanner::finishKey_() {
+  if (key_is_(key_, key_len_, "id")) {
+    field_ = Field::kId;
+  } else if (key_is_(key_, key_len_, "text")) {
+    field_ = Field::kText;
+  } else if (key_is_(key_, key_len_, "value")) {
+    field_ = Field::kValue;
+  } else if (!root_array_ && key_is_(key_, key_len_, "cfg")) {
+    field_ = Field::kCfg;
+  } else if (!root_array_ && key_is_(key_, key_len_, "snap")) {
+    field_ = Field::kSnap;
+  } else {
+    return false;
+  }
+
+  // An object is either an event or a snapshot, never both.
+  const bool snapshot_key = field_ == Field::kCfg || field_ == Field::kSnap;
+  if (snapshot_key) {
+    if (has_id_ || has_text_ || has_value_) return false;
+    snapshot_ = true;
+  } else if (snapshot_) {
+    return false;
+  }
+  return true;
+}
+
+// Starts a value in the current context; returns false if `c` cannot start one.
+bool EventScanner::startValue_(char c) {
+  const bool number = (c == '-' || (c >= '0' && c <= '9'));
+  bool want_number = false;
+  switch (context_) {
+    case Context::kObject: want_number = (field_ == Field::kValue); break;
+    case Context::kSnapElem: want_number = number; break;
+    case Context::kPairValue: want_number = true; break;
+    case Context::kPairText: want_number = false; break;
+  }
+
+  if (want_number) {
+    if (!number) return false;
+    number_neg_ = (c == '-');
+    number_ = number_neg_ ? 0 : (c - '0');
+    number_digits_ = number_neg_ ? 0 : 1;
+    state_ = State::kNumber;
+    return true;
+  }
+
+  if (c == 'n' && context_ == Context::kSnapElem) {
+    literal_pos_ = 1;
+    state_ = State::kLiteral;
+    return true;
+  }
+  if (c != '"') return false;
+
+  if (context_ == Context::kObject && field_ == Field::kId) {
+    id_len_ = 0;
+    has_id_ = true;
+  } else if (context_ == Context::kObject && field_ == Field::kCfg) {
+    cfg_len_ = 0;
+    has_cfg_ = true;
+  } else {
+    text_len_ = 0;
+    has_text_ = true;
+  }
+  state_ = State::kString;
+  return true;
+}
+
+bool EventScanner::appendStringChar_(char c) {
+  if (context_ == Context::kObject && field_ == Field::kId) {
+    if (id_len_ + 1 >= sizeof(id_)) return false;
+    id_[id_len_++] = c;
+  } else if (context_ == Context::kObject && field_ == Field::kCfg) {
+    if (cfg_len_ + 1 >= sizeof(cfg_)) return false;
+    cfg_[cfg_len_++] = c;
+  } else {
+    if (text_len_ + 1 >= sizeof(text_)) return false;
+    text_[text_len_++] = c;
+  }
+  return true;
+}
+
+bool EventScanner::finishNumber_() {
+  if (number_digits_ == 0) return false;
+  const int64_t v = number_neg_ ? -number_ : number_;
+  if (v < INT32_MIN || v > INT32_MAX) return false;
+  value_ = static_cast<int32_t>(v);
+  has_value_ = true;
+  return true;
+}
+
+// Called when a string, number or literal has been read completely.
+void EventScanner::valueDone_() {
+  switch (context_) {
+    case Context::kObject:
+      state_ = State::kObjNext;
+      break;
+    case Context::kSnapElem:
+      dispatchSnapshotItem_();
+      state_ = State::kSnapNext;
+      break;
+    case Context::kPairValue:
+      state_ = State::kPairComma;
+      break;
+    case Context::kPairText:
+      state_ = State::kPairEnd;
+      break;
+  }
+}
+
+void EventScanner::dispatchItem_() {
+  id_[id_len_] = '\0';
+  text_[text_len_] = '\0';
+  const Event event{Kind::kItem, has_id_ ? id_ : nullptr, has_text_ ? text_ : nullptr, has_value_, value_, 0};
+  ++dispatched_;
+  if (sink_ != nullptr && sink_(event, user_)) {
+    ++applied_;
+  }
+}
+
+void EventScanner::dispatchSnapshotItem_() {
+  const size_t index = snapshot_index_++;
+  if (!snapshot_accepted_) {
+    return;
+  }
+  text_[text_len_] = '\0';
+  const Event event{Kind::kSnapshotItem, nullptr, has_text_ ? text_ : nullptr, has_value_, value_, index};
+  ++dispatched_;
+  if (sink_ != nullptr && sink_(event, user_)) {
+    ++applied_;
+  }
+}
+
+EventScanner::Status EventScanner::feed(const char *data, size_t len) {
+  for (size_t i = 0; i < len && status_ != Status::kUnsupported;) {
+    if (step_(data[i])) {
+      ++i;
+    }
+  }
+  return status_;
+}
+
+// Advances the state machine by one byte. Returns false if the byte must be fed again
+// (it terminated a number and belongs to the next state).
+bool EventScanner::step_(char c) {
+  switch (state_) {
+    case State::kRoot:
+      if (is_ws_(c)) return true;
+      if (c == '[') {
+        root_array_ = true;
+        state_ = State::kArrayFirst;
+      } else if (c == '{') {
+        startObject_();
+      } else {
+        return fail_();
+      }
+      return true;
+
+    case State::kArrayFirst:
+    case State::kArrayItem:
+      if (is_ws_(c)) return true;
+      if (c == '{') {
+        startObject_();
+      } else if (c == ']' && state_ == State::kArrayFirst) {
+        state_ = State::kTrailing;
+        status_ = Status::kDone;
+      } else {
+        return fail_();
+      }
+      return true;
+
+    case State::kArrayNext:
+      if (is_ws_(c)) return true;
+      if (c == ',') {
+        state_ = State::kArrayItem;
+      } else if (c == ']') {
+        state_ = State::kTrailing;
+        status_ = Status::kDone;
+      } else {
+        return fail_();
+      }
+      return true;
+
+    case State::kObjFirst:
+    case State::kObjKeyStart:
+      if (is_ws_(c)) return true;
+      if (c == '"') {
+        key_len_ = 0;
+        state_ = State::kKey;
+        return true;
+      }
+      if (c == '}' && state_ == State::kObjFirst) {
+        state_ = State::kObjNext;
+        return false;
+      }
+      return fail_();
+
+    case State::kKey:
+      if (c == '"') {
+        if (!finishKey_()) return fail_();
+        state_ = State::kColon;
+      } else if (c == '\\' || key_len_ + 1 >= sizeof(key_)) {
+        return fail_();
+      } else {
+        key_[key_len_++] = c;
+      }
+      return true;
+
+    case State::kColon:
+      if (is_ws_(c)) return true;
+      if (c != ':') return fail_();
+      state_ = State::kValueStart;
+      return true;
+
+    case State::kValueStart:
+      if (is_ws_(c)) return true;
+      context_ = Context::kObject;
+      if (field_ == Field::kSnap) {
+        // Items are applied as they stream in, so the guard must be known first.
+        if (c != '[' || !has_cfg_) return fail_();
+        cfg_[cfg_len_] = '\0';
+        const Event event{Kind::kSnapshotBegin, nullptr, cfg_, false, 0, 0};
+        snapshot_accepted_ = (sink_ != nullptr && sink_(event, user_));
+        snapshot_index_ = 0;
+        state_ = State::kSnapFirst;
+        return true;
+      }
+      if (!startValue_(c)) return fail_();
+      return true;
+
+    case State::kString:
+      if (c == '"') {
+        valueDone_();
+      } else if (c == '\\') {
+        state_ = State::kStringEscape;
+      } else if (static_cast<unsigned char>(c) < 0x20 || !appendStringChar_(c)) {
+        return fail_();
+      }
+      return true;
+
+    case State::kStringEscape: {
+      char out;
+      switch (c) {
+        case '"': out = '"'; break;
+        case '\\': out = '\\'; break;
+        case '/': out = '/'; break;
+        case 'b': out = '\b'; break;
+        case 'f': out = '\f'; break;
+        case 'n': out = '\n'; break;
+        case 'r': out = '\r'; break;
+        case 't': out = '\t'; break;
+        default: return fail_(); // \uXXXX is left to the fallback parser
+      }
+      if (!appendStringChar_(out)) return fail_();
+      state_ = State::kString;
+      return true;
+    }
+
+    case State::kNumber:
+      if (c >= '0' && c <= '9') {
+        // JSON forbids leading zeros ("01"); 11 digits already exceed int32.
+        if ((number_digits_ == 1 && number_ == 0) || number_digits_ > 10) return fail_();
+        number_ = number_ * 10 + (c - '0');
+        ++number_digits_;
+        return true;
+      }
+      if (c == '.' || c == 'e' || c == 'E' || !finishNumber_()) return fail_(); // not an int32
+      valueDone_();
+      return false;
+
+    case State::kLiteral:
+      if (c != "null"[literal_pos_]) return fail_();
+      if (++literal_pos_ == 4) {
+        valueDone_();
+      }
+      return true;
+
+    case State::kObjNext:
+      if (is_ws_(c)) return true;
+      if (c == ',') {
+        state_ = State::kObjKeyStart;
+      } else if (c == '}') {
+        if (!snapshot_) {
+          dispatchItem_();
+        }
+        state_ = root_array_ ? State::kArrayNext : State::kTrailing;
+        if (!root_array_) {
+          status_ = Status::kDone;
+        }
+      } else {
+        return fail_();
+      }
+      return true;
+
+    case State::kSnapFirst:
+    case State::kSnapElem:
+      if (is_ws_(c)) return true;
+      if (c == ']' && state_ == State::kSnapFirst) {
+        context_ = Context::kObject;
+        state_ = State::kObjNext;
+        return true;
+      }
+      startElement_();
+      context_ = Context::kSnapElem;
+      if (c == '[') {
+        context_ = Context::kPairValue;
+        state_ = State::kPairValue;
+        return true;
+      }
+      if (!startValue_(c)) return fail_();
+      return true;
+
+    case State::kSnapNext:
+      if (is_ws_(c)) return true;
+      if (c == ',') {
+        state_ = State::kSnapElem;
+      } else if (c == ']') {
+        context_ = Context::kObject;
+        state_ = State::kObjNext;
+      } else {
+        return fail_();
+      }
+      return true;
+
+    case State::kPairValue:
+      if (is_ws_(c)) return true;
+      if (!startValue_(c)) return fail_();
+      return true;
+
+    case State::kPairComma:
+      if (is_ws_(c)) return true;
+      if (c != ',') return fail_();
+      context_ = Context::kPairText;
+      state_ = State::kPairText;
+      return true;
+
+    case State::kPairText:
+      if (is_ws_(c)) return true;
+      if (!startValue_(c)) return fail_();
+      return true;
+
+    case State::kPairEnd:
+      if (is_ws_(c)) return true;
+      if (c != ']') return fail_();
+      context_ = Context::kSnapElem;
+      valueDone_();
+      return true;
+
+    case State::kTrailing:
+      if (!is_ws_(c)) return fail_();
+      return true;
+  }
+  return fail_();
+}
+
+} // namespace live_dashboard
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "LiveDashboardLimits.h"
+
+namespace live_dashboard {
+
+// Single-pass scanner for the event line schema:
+//   {"id":"..","value":<int>,"text":".."}   or   [ {..}, {..}, ... ]
+// and for positional snapshots (values in config widget order, see LiveDashboard README):
+//   {"cfg":"<hash>","snap":[<int>, "<text>", [<int>,"<text>"], null, ...]}
+//
+// Bytes are fed in order (in chunks of any size) and each item is handed to the sink as soon
+// as it is complete, without building a document, so the number of items and the length of
+// the input are not bounded by memory. Anything outside the schema (unknown keys, floats,
+// other literals, \u escapes, over-long strings, "snap" before "cfg") stops the scanner with
+// kUnsupported so the caller can fall back to a general JSON parser; dispatched() tells how
+// many items were already delivered by then.
+class EventScanner {
+public:
+  enum class Kind : uint8_t {
+    kItem,          // keyed event object
+    kSnapshotBegin, // text = cfg; returning false skips the snapshot's items
+    kSnapshotItem,  // index = position in the snapshot; id is nullptr
+  };
+
+  struct Event {
+    Kind kind;
+    const char *id;   // nullptr if missing
+    const char *text; // nullptr if missing
+    bool has_value;
+    int32_t value;
+    size_t index;
+  };
+
+  // Returns true if the item was applied.
+  using Sink = bool (*)(const Event &event, void *user);
+
+  enum class Status : uint8_t {
+    kNeedMore,    // root not closed yet
+    kDone,        // root closed; only whitespace may follow
+    kUnsupported, // outside the schema (or malformed); fall back to a full parser
+  };
+
+  void begin(Sink sink, void *user);
+  Status feed(const char *data, size_t len);
+  Status status() const { return status_; }
+
+  // Items (keyed or positional) handed to the sink so far, and how many of those it applied.
+  size_t dispatched() const { return dispatched_; }
+  size_t applied() const { return applied_; }
+
+private:
+  enum class State : uint8_t {
+    kRoot,
+    kArrayFirst,   // after '[': '{' or ']'
+    kArrayItem,    // after ',': '{'
+    kArrayNext,    // after an item: ',' or ']'
+    kObjFirst,     // after '{': '"' or '}'
+    kObjKeyStart,  // after ',': '"'
+    kKey,
+    kColon,
+    kValueStart,
+    kString,
+    kStringEscape,
+    kNumber,
+    kLiteral,      // "null" (snapshot elements only)
+    kObjNext,      // after a value: ',' or '}'
+    kSnapFirst,    // after "snap":[ : element or ']'
+    kSnapElem,     // after ',': element
+    kSnapNext,     // after an element: ',' or ']'
+    kPairValue,    // after '[' inside snap: number
+    kPairComma,
+    kPairText,
+    kPairEnd,
+    kTrailing,
+  };
+
+  enum class Field : uint8_t { kNone, kId, kText, kValue, kCfg, kSnap };
+  enum class Context : uint8_t { kObject, kSnapElem, kPairValue, kPairText };
+
+  bool step_(char c);
+  bool fail_();
+  void startObject_();
+  void startElement_();
+  bool finishKey_();
+  bool startValue_(char c);
+  bool appendStringChar_(char c);
+  bool finishNumber_();
+  void valueDone_();
+  void dispatchItem_();
+  void dispatchSnapshotItem_();
+
+  Sink sink_ = nullptr;
+  void *user_ = nullptr;
+  Status status_ = Status::kNeedMore;
+  State state_ = State::kRoot;
+  Field field_ = Field::kNone;
+  Context context_ = Context::kObject;
+  bool root_array_ = false;
+  bool snapshot_ = false; // root object is a snapshot
+  bool snapshot_accepted_ = false;
+  size_t snapshot_index_ = 0;
+  size_t dispatched_ = 0;
+  size_t applied_ = 0;
+
+  char key_[8]{};
+  size_t key_len_ = 0;
+  uint8_t literal_pos_ = 0;
+
+  char id_[LIVE_DASHBOARD_ID_MAX_LEN]{};
+  size_t id_len_ = 0;
+  bool has_id_ = false;
+  char text_[LIVE_DASHBOARD_TEXT_MAX_LEN]{};
+  size_t text_len_ = 0;
+  bool has_text_ = false;
+  char cfg_[16]{};
+  size_t cfg_len_ = 0;
+  bool has_cfg_ = false;
+
+  int64_t number_ = 0;
+  bool number_neg_ = false;
+  uint8_t number_digits_ = 0;
+  int32_t value_ = 0;
+  bool has_value_ = false;
+};
+
+} // namespace live_dashboard
@@ -1,14 +1,43 @@
 #include "LiveDashboard.h"
+#include "EventScanner.h"
+#include "UpdateQueue.h"
+#include "ValueFormat.h"
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <lvgl.h>
 
+#include "esp_heap_caps.h"
+
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <new>
+
+// Boot-time heap use and restyle/redraw timing of the built dashboard.
+#ifndef LIVE_DASHBOARD_BENCH_STYLES
+#define LIVE_DASHBOARD_BENCH_STYLES 0
+#endif
+
+// Boot-time per-redraw time of one gauge with the lv_arc and the masked arc renderer.
+#ifndef LIVE_DASHBOARD_BENCH_ARC
+#define LIVE_DASHBOARD_BENCH_ARC 0
+#endif
+
+// Boot-time events/s comparison of the event line scanner vs. ArduinoJson on the demo file.
+#ifndef LIVE_DASHBOARD_BENCH_PARSER
+#define LIVE_DASHBOARD_BENCH_PARSER 0
+#endif
+
+// Boot-time stale scan / tick / publish cost of the widget hot state at 24, 128 and 512 widgets,
+// against the interleaved per-widget layout it replaced, plus tick() and publish on this config.
+#ifndef LIVE_DASHBOARD_BENCH_HOT
+#define LIVE_DASHBOARD_BENCH_HOT 0
+#endif
 
 namespace live_dashboard {
 namespace {
@@ -20,11 +49,31 @@ static const lv_color_t kTextSecondary = lv_color_hex(0x94A3B8);
 static const lv_color_t kArcBg = lv_color_hex(0x334155);
 static const lv_color_t kStaleArc = lv_color_hex(0x475569);
 
+// Objects showing a value that timed out are put in this state; the shared styles below
+// switch them to the stale colors, so going stale/fresh touches no style properties.
+static constexpr lv_state_t kStateStale = LV_STATE_USER_1;
+
+// Objects that change after build (gauge arcs/values, hz rows, buttons). With ui.static_background
+// everything else is baked into one screen-sized image and hidden.
+static constexpr lv_obj_flag_t kFlagLive = LV_OBJ_FLAG_USER_1;
+
 static constexpr size_t kMaxStagesPerGauge = 8;
 static constexpr size_t kEventLineMaxLen = 1024;
-static constexpr size_t kMaxEventsPerLine = 10;
+// ArduinoJson pool for the fallback parse of one event line. Lines are parsed in place, so
+// strings stay in the line and the pool only holds value slots. Every value but the last needs a
+// separator, so no line of kEventLineMaxLen bytes holds more than (len + 1) / 2 of them
+// ("0,0,..." in a snapshot, "{},{},..." in an array), and nested arrays or object members only
+// use more bytes per slot. That is 8 KiB with ESP32's 16-byte slots.
+static constexpr size_t kEventDocSize = JSON_ARRAY_SIZE((kEventLineMaxLen + 1) / 2);
 static constexpr size_t kMaxHzRowsPerList = 6;
 
+// Hz list geometry. Rows are placed at fixed positions when the list is built (no flex layout),
+// and value labels have a fixed box, so a text update only invalidates its own label.
+static constexpr lv_coord_t kHzListTitleGap = 8;
+static constexpr lv_coord_t kHzRowGap = 6;
+static constexpr lv_coord_t kHzRowHeight = 40;
+static constexpr lv_coord_t kHzTextRowHeight = 32;
+
 struct Stage {
   int32_t threshold;
   lv_color_t color;
@@ -160,14 +209,108 @@ static lv_color_t pick_stage_color_(int32_t value, const Stage *stages, size_t s
   return stages[stage_count - 1].color;
 }
 
+// Styles shared by all dashboard objects. (Re)built in build_from_json_ and attached
+// by reference, so objects carry no local copies of identical colors, fonts and paddings.
+// Only value-dependent colors (arc/bar indicators, button colors) remain local.
+struct DashboardStyles {
+  bool ready = false;
+  lv_style_t tile;
+  lv_style_t transparent;  // no bg/border/padding (grid, hz lists and rows)
+  lv_style_t baked;        // no bg/border: parents of live objects over the static background
+  lv_style_t title;        // primary, 16 px
+  lv_style_t label;        // primary, 14 px
+  lv_style_t label_dim;    // secondary, 14 px
+  lv_style_t caption;      // secondary, 12 px
+  lv_style_t gauge_value;  // primary, 28 px, centered
+  lv_style_t stale_text;   // with kStateStale
+  lv_style_t arc_main;
+  lv_style_t arc_indicator;
+  lv_style_t arc_indicator_stale;
+  lv_style_t bar_main;
+  lv_style_t bar_indicator;
+  lv_style_t bar_indicator_stale;
+  lv_style_t button;
+};
+
+static DashboardStyles g_styles;
+
+static void init_styles_() {
+  DashboardStyles &st = g_styles;
+  lv_style_t *all[] = {&st.tile, &st.transparent, &st.baked, &st.title, &st.label,
+                       &st.label_dim, &st.caption, &st.gauge_value, &st.stale_text, &st.arc_main,
+                       &st.arc_indicator, &st.arc_indicator_stale, &st.bar_main, &st.bar_indicator,
+                       &st.bar_indicator_stale, &st.button};
+  for (lv_style_t *style : all) {
+    if (st.ready) {
+      lv_style_reset(style);
+    }
+    lv_style_init(style);
+  }
+
+  lv_style_set_bg_color(&st.tile, kTileBg);
+  lv_style_set_bg_opa(&st.tile, LV_OPA_COVER);
+  lv_style_set_border_width(&st.tile, 2);
+  lv_style_set_border_color(&st.tile, kTileBorder);
+  lv_style_set_radius(&st.tile, 0);
+  lv_style_set_pad_all(&st.tile, 10);
+
+  lv_style_set_bg_opa(&st.transparent, LV_OPA_TRANSP);
+  lv_style_set_border_width(&st.transparent, 0);
+  lv_style_set_pad_all(&st.transparent, 0);
+  lv_style_set_pad_row(&st.transparent, 0);
+  lv_style_set_pad_column(&st.transparent, 0);
+
+  lv_style_set_bg_opa(&st.baked, LV_OPA_TRANSP);
+  lv_style_set_border_width(&st.baked, 0);
+  lv_style_set_shadow_width(&st.baked, 0);
+  lv_style_set_outline_width(&st.baked, 0);
+
+  lv_style_set_text_color(&st.title, kTextPrimary);
+  lv_style_set_text_font(&st.title, &lv_font_montserrat_16);
+
+  lv_style_set_text_color(&st.label, kTextPrimary);
+  lv_style_set_text_font(&st.label, &lv_font_montserrat_14);
+
+  lv_style_set_text_color(&st.label_dim, kTextSecondary);
+  lv_style_set_text_font(&st.label_dim, &lv_font_montserrat_14);
+
+  lv_style_set_text_color(&st.caption, kTextSecondary);
+  lv_style_set_text_font(&st.caption, &lv_font_montserrat_12);
+
+  lv_style_set_text_color(&st.gauge_value, kTextPrimary);
+  lv_style_set_text_font(&st.gauge_value, &lv_font_montserrat_28);
+  lv_style_set_text_align(&st.gauge_value, LV_TEXT_ALIGN_CENTER);
+
+  lv_style_set_text_color(&st.stale_text, kTextSecondary);
+
+  lv_style_set_arc_width(&st.arc_main, 14);
+  lv_style_set_arc_color(&st.arc_main, kArcBg);
+  lv_style_set_bg_opa(&st.arc_main, LV_OPA_TRANSP);
+  lv_style_set_border_width(&st.arc_main, 0);
+
+  lv_style_set_arc_width(&st.arc_indicator, 14);
+  lv_style_set_arc_rounded(&st.arc_indicator, true);
+
+  lv_style_set_arc_color(&st.arc_indicator_stale, kStaleArc);
+
+  lv_style_set_bg_color(&st.bar_main, kArcBg);
+  lv_style_set_radius(&st.bar_main, 4);
+  lv_style_set_border_width(&st.bar_main, 0);
+
+  lv_style_set_bg_color(&st.bar_indicator, kStaleArc);
+  lv_style_set_radius(&st.bar_indicator, 4);
+
+  lv_style_set_bg_color(&st.bar_indicator_stale, kStaleArc);
+
+  lv_style_set_bg_opa(&st.button, LV_OPA_COVER);
+  lv_style_set_radius(&st.button, 12);
+
+  st.ready = true;
+}
+
 static lv_obj_t *create_tile_(lv_obj_t *parent) {
   lv_obj_t *tile = lv_obj_create(parent);
-  lv_obj_set_style_bg_color(tile, kTileBg, LV_PART_MAIN);
-  lv_obj_set_style_bg_opa(tile, LV_OPA_COVER, LV_PART_MAIN);
-  lv_obj_set_style_border_width(tile, 2, LV_PART_MAIN);
-  lv_obj_set_style_border_color(tile, kTileBorder, LV_PART_MAIN);
-  lv_obj_set_style_radius(tile, 0, LV_PART_MAIN);
-  lv_obj_set_style_pad_all(tile, 10, LV_PART_MAIN);
+  lv_obj_add_style(tile, &g_styles.tile, LV_PART_MAIN);
   lv_obj_clear_flag(tile, LV_OBJ_FLAG_SCROLLABLE);
   return tile;
 }
@@ -263,6 +406,109 @@ static bool show_splash_from_lvgl_path_(const char *lvgl_path,
   return true;
 }
 
+// Copies `text` into a label's static text buffer. Returns false if it already held that text.
+static bool update_text_buffer_(char *buf, size_t buf_size, const char *text) {
+  if (text == nullptr) {
+    text = "";
+  }
+  if (strncmp(buf, text, buf_size - 1) == 0) {
+    return false;
+  }
+  copy_cstr(buf, buf_size, text);
+  return true;
+}
+
+// Value text length (without the terminator) of a widget: its `text_max_len`, else
+// `default_len`. 0 if the key is present but not 1..LIVE_DASHBOARD_TEXT_MAX_LEN - 1.
+static size_t widget_text_len_(JsonObject widget, size_t default_len) {
+  JsonVariant v = widget["text_max_len"];
+  if (v.isNull()) {
+    return default_len;
+  }
+  if (!v.is<uint8_t>()) {
+    return 0;
+  }
+  const size_t len = v.as<uint8_t>();
+  return (len == 0 || len >= LIVE_DASHBOARD_TEXT_MAX_LEN) ? 0 : len;
+}
+
+// Masked arc gauges: the 270 degree ring of a gauge is precomputed once as per-pixel coverage
+// plus an angle step along the sweep (rounded end caps included), shared by all masked gauges.
+// A redraw is then one pass over the ring picking indicator or track color per pixel, instead
+// of LVGL's anti-aliased arc/circle mask math.
+static constexpr lv_coord_t kArcSize = 120;
+static constexpr lv_coord_t kArcWidth = 14;
+static constexpr float kArcStartDeg = 135.0f;
+static constexpr float kArcSweepDeg = 270.0f;
+
+struct ArcRingMask {
+  uint8_t *alpha = nullptr; // kArcSize * kArcSize ring coverage
+  uint8_t *step = nullptr;  // angle step 0..255 along the sweep
+};
+
+static ArcRingMask g_arc_mask;
+
+static float clamp01_(float v) {
+  return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+}
+
+static bool build_arc_ring_mask_() {
+  if (g_arc_mask.alpha != nullptr) {
+    return true;
+  }
+  const size_t n = static_cast<size_t>(kArcSize) * kArcSize;
+  uint8_t *buf = static_cast<uint8_t *>(heap_caps_malloc(2 * n, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  if (buf == nullptr) {
+    buf = static_cast<uint8_t *>(heap_caps_malloc(2 * n, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  }
+  if (buf == nullptr) {
+    return false;
+  }
+
+  constexpr float kDegToRad = 3.14159265f / 180.0f;
+  const float c = kArcSize / 2.0f;
+  const float r_out = c;
+  const float r_in = c - kArcWidth;
+  const float r_mid = c - kArcWidth / 2.0f;
+  const float cap_r = kArcWidth / 2.0f;
+  const float cap0_x = c + r_mid * cosf(kArcStartDeg * kDegToRad);
+  const float cap0_y = c + r_mid * sinf(kArcStartDeg * kDegToRad);
+  const float cap1_x = c + r_mid * cosf((kArcStartDeg + kArcSweepDeg) * kDegToRad);
+  const float cap1_y = c + r_mid * sinf((kArcStartDeg + kArcSweepDeg) * kDegToRad);
+
+  for (lv_coord_t y = 0; y < kArcSize; ++y) {
+    for (lv_coord_t x = 0; x < kArcSize; ++x) {
+      const float px = x + 0.5f;
+      const float py = y + 0.5f;
+      const float dx = px - c;
+      const float dy = py - c;
+      const float r = sqrtf(dx * dx + dy * dy);
+      // Screen y grows downwards, so atan2 runs clockwise like LVGL arc angles.
+      float rel = atan2f(dy, dx) / kDegToRad - kArcStartDeg;
+      while (rel < 0.0f) rel += 360.0f;
+
+      float cov;
+      uint8_t step;
+      if (rel <= kArcSweepDeg) {
+        cov = clamp01_(r_out - r + 0.5f) * clamp01_(r - r_in + 0.5f);
+        step = static_cast<uint8_t>(lroundf(rel * 255.0f / kArcSweepDeg));
+      } else {
+        const float d0 = sqrtf((px - cap0_x) * (px - cap0_x) + (py - cap0_y) * (py - cap0_y));
+        const float d1 = sqrtf((px - cap1_x) * (px - cap1_x) + (py - cap1_y) * (py - cap1_y));
+        cov = clamp01_(cap_r - (d0 < d1 ? d0 : d1) + 0.5f);
+        step = d0 < d1 ? 0 : 255;
+      }
+      const size_t i = static_cast<size_t>(y) * kArcSize + x;
+      buf[i] = static_cast<uint8_t>(cov * 255.0f + 0.5f);
+      buf[n + i] = step;
+    }
+  }
+
+  g_arc_mask.alpha = buf;
+  g_arc_mask.step = buf + n;
+  return true;
+}
+
 class ArcGauge {
 public:
   void create(lv_obj_t *tile,
@@ -277,92 +523,88 @@ public:
               lv_color_t accent_color,
               const Stage *stages,
               size_t stage_count,
-              uint32_t stale_timeout_ms,
-              const char *stale_text) {
+              const char *stale_text,
+              bool masked,
+              char *text_buf,
+              size_t text_buf_size) {
     tile_ = tile;
+    text_ = text_buf;
+    text_size_ = text_buf_size;
     min_value_ = min_value;
     max_value_ = max_value;
     accent_color_ = accent_color;
     stages_ = stages;
     stage_count_ = stage_count;
-    stale_timeout_ms_ = stale_timeout_ms;
     stale_text_ = (stale_text != nullptr && stale_text[0] != '\0') ? stale_text : "--";
 
     lv_obj_t *title_label = lv_label_create(tile_);
     lv_label_set_text(title_label, title != nullptr ? title : "");
-    lv_obj_set_style_text_color(title_label, kTextPrimary, LV_PART_MAIN);
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_16, LV_PART_MAIN);
+    lv_obj_add_style(title_label, &g_styles.title, LV_PART_MAIN);
     lv_obj_align(title_label, LV_ALIGN_TOP_LEFT, 0, 0);
 
-    arc_ = lv_arc_create(tile_);
-    lv_obj_set_size(arc_, 120, 120);
-    lv_arc_set_rotation(arc_, 135);
-    lv_arc_set_bg_angles(arc_, 0, 270);
-    lv_arc_set_range(arc_, min_value_, max_value_);
-    lv_obj_set_style_arc_width(arc_, 14, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(arc_, 14, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(arc_, kArcBg, LV_PART_MAIN);
-    lv_obj_set_style_arc_rounded(arc_, true, LV_PART_INDICATOR);
-    lv_obj_set_style_bg_opa(arc_, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(arc_, 0, LV_PART_MAIN);
-    lv_obj_remove_style(arc_, nullptr, LV_PART_KNOB);
+    masked_ = false;
+    arc_step_ = -1;
+    if (masked && !build_arc_ring_mask_()) {
+      Serial.println("Gauge: no memory for the arc mask, using lv_arc");
+      masked = false;
+    }
+    if (masked) {
+      masked_ = true;
+      arc_ = lv_obj_create(tile_);
+      lv_obj_set_size(arc_, kArcSize, kArcSize);
+      lv_obj_add_style(arc_, &g_styles.transparent, LV_PART_MAIN);
+      lv_obj_clear_flag(arc_, LV_OBJ_FLAG_SCROLLABLE);
+      lv_obj_add_event_cb(arc_, maskedArcDrawCb_, LV_EVENT_DRAW_MAIN, this);
+    } else {
+      arc_ = lv_arc_create(tile_);
+      lv_obj_set_size(arc_, kArcSize, kArcSize);
+      lv_arc_set_rotation(arc_, static_cast<uint16_t>(kArcStartDeg));
+      lv_arc_set_bg_angles(arc_, 0, static_cast<uint16_t>(kArcSweepDeg));
+      lv_arc_set_range(arc_, min_value_, max_value_);
+      lv_obj_add_style(arc_, &g_styles.arc_main, LV_PART_MAIN);
+      lv_obj_add_style(arc_, &g_styles.arc_indicator, LV_PART_INDICATOR);
+      lv_obj_add_style(arc_, &g_styles.arc_indicator_stale, LV_PART_INDICATOR | kStateStale);
+      lv_obj_remove_style(arc_, nullptr, LV_PART_KNOB);
+    }
     lv_obj_clear_flag(arc_, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(arc_, kFlagLive);
     lv_obj_align(arc_, LV_ALIGN_CENTER, 0, 8);
 
     value_label_ = lv_label_create(tile_);
-    lv_obj_set_style_text_color(value_label_, kTextPrimary, LV_PART_MAIN);
-    lv_obj_set_style_text_font(value_label_, &lv_font_montserrat_28, LV_PART_MAIN);
+    lv_obj_add_style(value_label_, &g_styles.gauge_value, LV_PART_MAIN);
+    lv_obj_add_style(value_label_, &g_styles.stale_text, LV_PART_MAIN | kStateStale);
     lv_obj_set_width(value_label_, LV_PCT(100));
-    lv_obj_set_style_text_align(value_label_, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    lv_label_set_text(value_label_, "");
+    lv_obj_add_flag(value_label_, kFlagLive);
+    text_[0] = '\0';
+    lv_label_set_text_static(value_label_, text_);
     lv_obj_align_to(value_label_, arc_, LV_ALIGN_CENTER, 2, 8);
 
     if (min_label != nullptr && max_label != nullptr) {
       lv_obj_t *min_value_label = lv_label_create(tile_);
       lv_label_set_text(min_value_label, min_label);
-      lv_obj_set_style_text_color(min_value_label, kTextSecondary, LV_PART_MAIN);
-      lv_obj_set_style_text_font(min_value_label, &lv_font_montserrat_12, LV_PART_MAIN);
+      lv_obj_add_style(min_value_label, &g_styles.caption, LV_PART_MAIN);
       lv_obj_align(min_value_label, LV_ALIGN_BOTTOM_LEFT, 0, 0);
 
       lv_obj_t *max_value_label = lv_label_create(tile_);
       lv_label_set_text(max_value_label, max_label);
-      lv_obj_set_style_text_color(max_value_label, kTextSecondary, LV_PART_MAIN);
-      lv_obj_set_style_text_font(max_value_label, &lv_font_montserrat_12, LV_PART_MAIN);
+      lv_obj_add_style(max_value_label, &g_styles.caption, LV_PART_MAIN);
       lv_obj_align(max_value_label, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
     }
 
-    has_value_ = false;
-    is_stale_ = false;
-    last_update_ms_ = 0;
-    value_ = min_value_;
+    has_indicator_color_ = false;
 
     if (publish_initial) {
-      publish(initial_value, initial_text, millis());
+      show(initial_value, initial_text, false);
     } else {
-      is_stale_ = true;
-      applyStale_();
+      showStale();
     }
   }
 
-  void publish(int32_t value, const char *value_text, uint32_t now_ms) {
-    value_ = value;
-    last_update_ms_ = now_ms;
-    has_value_ = true;
-
-    is_stale_ = false;
-    applyFresh_(value_, value_text);
-  }
-
-  void tick(uint32_t now_ms) {
-    if (arc_ == nullptr || value_label_ == nullptr) {
-      return;
-    }
-    bool stale = !has_value_ || (stale_timeout_ms_ > 0 && (now_ms - last_update_ms_ > stale_timeout_ms_));
-    if (stale && !is_stale_) {
-      is_stale_ = true;
-      applyStale_();
-    }
-  }
+  // Rendering only: freshness, timestamps and the last value live in the dashboard's
+  // WidgetHotState, which decides when to call these.
+  void show(int32_t value, const char *value_text, bool was_stale) { applyFresh_(value, value_text, was_stale); }
+  void showStale() { applyStale_(); }
+  bool live() const { return arc_ != nullptr && value_label_ != nullptr; }
 
 private:
   lv_color_t indicatorColorForValue_(int32_t value) const {
@@ -372,21 +614,138 @@ private:
     return accent_color_;
   }
 
-  void applyFresh_(int32_t value, const char *value_text) {
+  // The value label shows text_ (or stale_text_) as static text, so updates never go through
+  // the heap; it is only re-laid out when the text actually changes.
+  void applyFresh_(int32_t value, const char *value_text, bool was_stale) {
     if (value < min_value_) value = min_value_;
     if (value > max_value_) value = max_value_;
 
-    lv_arc_set_value(arc_, value);
-    lv_obj_set_style_arc_color(arc_, indicatorColorForValue_(value), LV_PART_INDICATOR);
-    lv_obj_set_style_text_color(value_label_, kTextPrimary, LV_PART_MAIN);
-    lv_label_set_text(value_label_, value_text != nullptr ? value_text : "");
+    setArcValue_(value);
+    const lv_color_t color = indicatorColorForValue_(value);
+    if (!has_indicator_color_ || color.full != indicator_color_.full) {
+      if (masked_) {
+        lv_obj_invalidate(arc_);
+      } else {
+        lv_obj_set_style_arc_color(arc_, color, LV_PART_INDICATOR);
+      }
+      indicator_color_ = color;
+      has_indicator_color_ = true;
+    }
+    if (was_stale) {
+      lv_obj_clear_state(arc_, kStateStale);
+      lv_obj_clear_state(value_label_, kStateStale);
+    }
+    if (update_text_buffer_(text_, text_size_, value_text) || was_stale) {
+      lv_label_set_text_static(value_label_, text_);
+    }
+  }
+
+  void setArcValue_(int32_t value) {
+    if (!masked_) {
+      lv_arc_set_value(arc_, value);
+      return;
+    }
+    int16_t step = -1;
+    if (value > min_value_ && max_value_ > min_value_) {
+      step = static_cast<int16_t>((static_cast<int64_t>(value - min_value_) * 255) / (max_value_ - min_value_));
+    }
+    if (step != arc_step_) {
+      arc_step_ = step;
+      lv_obj_invalidate(arc_);
+    }
+  }
+
+  // Blends the ring straight into the draw buffer: indicator color up to arc_step_, track color
+  // after it, plus a rounded cap at the indicator end. Coverage is scaled by the object's
+  // inherited style opacity, as LVGL's own draw descriptors are.
+  static void maskedArcDrawCb_(lv_event_t *e) {
+    const ArcGauge *self = static_cast<const ArcGauge *>(lv_event_get_user_data(e));
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    if (self == nullptr || draw_ctx == nullptr || g_arc_mask.alpha == nullptr) {
+      return;
+    }
+    lv_obj_t *obj = lv_event_get_target(e);
+    const lv_opa_t opa = lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN);
+    if (opa <= LV_OPA_MIN) {
+      return;
+    }
+    const bool translucent = opa < LV_OPA_MAX;
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, &coords, draw_ctx->clip_area)) {
+      return;
+    }
+
+    lv_color_t *buf = static_cast<lv_color_t *>(draw_ctx->buf);
+    const lv_area_t *buf_area = draw_ctx->buf_area;
+    const lv_coord_t stride = lv_area_get_width(buf_area);
+    const int16_t v = self->arc_step_;
+    const lv_color_t track = kArcBg;
+    const lv_color_t indicator = self->indicator_color_;
+    const lv_coord_t w = lv_area_get_width(&area);
+
+    for (lv_coord_t y = area.y1; y <= area.y2; ++y) {
+      const size_t mask_off = static_cast<size_t>(y - coords.y1) * kArcSize + (area.x1 - coords.x1);
+      const uint8_t *alpha = g_arc_mask.alpha + mask_off;
+      const uint8_t *step = g_arc_mask.step + mask_off;
+      lv_color_t *dst = buf + static_cast<size_t>(y - buf_area->y1) * stride + (area.x1 - buf_area->x1);
+      for (lv_coord_t i = 0; i < w; ++i) {
+        const uint8_t m = translucent ? static_cast<uint8_t>(LV_OPA_MIX2(alpha[i], opa)) : alpha[i];
+        if (m == 0) {
+          continue;
+        }
+        const lv_color_t c = step[i] <= v ? indicator : track;
+        dst[i] = m == 255 ? c : lv_color_mix(c, dst[i], m);
+      }
+    }
+
+    if (v < 0 || v >= 255) {
+      return;
+    }
+    constexpr float kDegToRad = 3.14159265f / 180.0f;
+    const float half = kArcSize / 2.0f;
+    const float r_mid = half - kArcWidth / 2.0f;
+    const float cap_r = kArcWidth / 2.0f;
+    const float deg = kArcStartDeg + v * kArcSweepDeg / 255.0f;
+    const float cx = half + r_mid * cosf(deg * kDegToRad);
+    const float cy = half + r_mid * sinf(deg * kDegToRad);
+    lv_area_t cap;
+    lv_area_set(&cap,
+                coords.x1 + static_cast<lv_coord_t>(cx - cap_r) - 1,
+                coords.y1 + static_cast<lv_coord_t>(cy - cap_r) - 1,
+                coords.x1 + static_cast<lv_coord_t>(cx + cap_r) + 1,
+                coords.y1 + static_cast<lv_coord_t>(cy + cap_r) + 1);
+    if (!_lv_area_intersect(&cap, &cap, &area)) {
+      return;
+    }
+    for (lv_coord_t y = cap.y1; y <= cap.y2; ++y) {
+      for (lv_coord_t x = cap.x1; x <= cap.x2; ++x) {
+        const size_t i = static_cast<size_t>(y - coords.y1) * kArcSize + (x - coords.x1);
+        if (g_arc_mask.step[i] <= v || g_arc_mask.alpha[i] == 0) {
+          continue;
+        }
+        const float dx = (x - coords.x1) + 0.5f - cx;
+        const float dy = (y - coords.y1) + 0.5f - cy;
+        const float cov = clamp01_(cap_r - sqrtf(dx * dx + dy * dy) + 0.5f) * 255.0f;
+        uint8_t m = static_cast<uint8_t>(cov < g_arc_mask.alpha[i] ? cov : g_arc_mask.alpha[i]);
+        if (translucent) {
+          m = static_cast<uint8_t>(LV_OPA_MIX2(m, opa));
+        }
+        if (m == 0) {
+          continue;
+        }
+        lv_color_t *dst = buf + static_cast<size_t>(y - buf_area->y1) * stride + (x - buf_area->x1);
+        *dst = lv_color_mix(indicator, *dst, m);
+      }
+    }
   }
 
   void applyStale_() {
-    lv_arc_set_value(arc_, min_value_);
-    lv_obj_set_style_arc_color(arc_, kStaleArc, LV_PART_INDICATOR);
-    lv_obj_set_style_text_color(value_label_, kTextSecondary, LV_PART_MAIN);
-    lv_label_set_text(value_label_, stale_text_);
+    setArcValue_(min_value_);
+    lv_obj_add_state(arc_, kStateStale);
+    lv_obj_add_state(value_label_, kStateStale);
+    lv_label_set_text_static(value_label_, stale_text_);
   }
 
   lv_obj_t *tile_ = nullptr;
@@ -395,14 +754,15 @@ private:
 
   int32_t min_value_ = 0;
   int32_t max_value_ = 100;
-  int32_t value_ = 0;
-  bool has_value_ = false;
-  bool is_stale_ = true;
-  uint32_t last_update_ms_ = 0;
-  uint32_t stale_timeout_ms_ = 0;
-  const char *stale_text_ = "--";
+  const char *stale_text_ = "--"; // points into the config document, which stays allocated
+  char *text_ = nullptr; // text_size_ bytes in the dashboard's text pool
+  size_t text_size_ = 0;
 
   lv_color_t accent_color_ = lv_palette_main(LV_PALETTE_BLUE);
+  lv_color_t indicator_color_{};
+  bool has_indicator_color_ = false;
+  bool masked_ = false;
+  int16_t arc_step_ = -1; // masked: indicator end step (0..255), -1 for none
   const Stage *stages_ = nullptr;
   size_t stage_count_ = 0;
 };
@@ -420,6 +780,7 @@ struct TileSlot {
 struct GaugeSlot {
   bool used = false;
   char id[LIVE_DASHBOARD_ID_MAX_LEN]{};
+  ValueFormat format{};
   ArcGauge gauge{};
   Stage stages[kMaxStagesPerGauge]{};
   size_t stage_count = 0;
@@ -439,14 +800,246 @@ struct HzRowSlot {
   bool text_only = false;
   bool negative_polarity = false;
   int32_t target = 0;
+  ValueFormat format{};
+  char *text = nullptr; // in the text pool: static text of value_label (hz rows), drawn text (compact rows)
+  size_t text_size = 0;  // 0 for text rows outside compact lists (LVGL-owned label text)
   lv_obj_t *name_label = nullptr;
   lv_obj_t *value_label = nullptr;
   lv_obj_t *bar = nullptr;
-  uint32_t last_update_ms = 0;
-  bool has_value = false;
-  bool is_stale = true;
+  lv_obj_t *compact = nullptr; // compact rows: the single object drawing label, value and bar
+  int16_t ratio_permille = 0;  // compact rows: bar fill
+  lv_color_t bar_color{};
+  bool has_bar_color = false;
+};
+
+// An update published from another task, already validated and formatted, waiting for the
+// UI task. Widgets are addressed by slot index so the UI task does no lookup.
+struct QueuedUpdate {
+  enum Kind : uint8_t { kGauge, kHzRow };
+  Kind kind;
+  uint16_t index;
+  int32_t value;
+  char text[LIVE_DASHBOARD_TEXT_MAX_LEN];
+};
+
+using UpdateQueue = MpscQueue<QueuedUpdate, LIVE_DASHBOARD_UPDATE_QUEUE_LEN>;
+
+// Per-widget arrays are indexed by widget slot: gauges first, hz rows from kRowWidgetBase.
+static constexpr size_t kRowWidgetBase = LIVE_DASHBOARD_MAX_GAUGES;
+static constexpr size_t kWidgetSlots = LIVE_DASHBOARD_MAX_GAUGES + LIVE_DASHBOARD_MAX_HZ_ROWS;
+
+// What every publish and stale check reads or writes, one array per field and apart from
+// GaugeSlot / HzRowSlot (ids, labels, formats, stages, LVGL handles), so those paths only pull
+// in the bytes they use.
+template <size_t N>
+struct WidgetHotState {
+  enum : uint8_t {
+    kLive = 1,     // LVGL objects exist; publishes are accepted
+    kHasValue = 2, // published at least once (or has an `initial` value)
+    kStale = 4,    // showing the stale placeholder
+  };
+  uint32_t last_update_ms[N]{};
+  int32_t value[N]{};
+  uint8_t flags[N]{};
+};
+
+// Widgets that can still go stale, least recently updated first. All widgets share one
+// stale_timeout_ms, so update order is also stale-deadline order: publishing moves a widget to
+// the back in O(1), tick() pops expired widgets off the front and the next deadline is the
+// front's.
+template <size_t kSize>
+class StaleList {
+public:
+  static_assert(kSize < 0xFFFF, "StaleList indices are 16-bit");
+
+  void reset() {
+    head_ = kNone;
+    tail_ = kNone;
+    for (size_t i = 0; i < kSize; ++i) {
+      linked_[i] = false;
+    }
+  }
+
+  void moveToBack(size_t entry) {
+    remove(entry);
+    const uint16_t e = static_cast<uint16_t>(entry);
+    prev_[e] = tail_;
+    next_[e] = kNone;
+    if (tail_ != kNone) {
+      next_[tail_] = e;
+    } else {
+      head_ = e;
+    }
+    tail_ = e;
+    linked_[e] = true;
+  }
+
+  void remove(size_t entry) {
+    if (!linked_[entry]) {
+      return;
+    }
+    const uint16_t prev = prev_[entry];
+    const uint16_t next = next_[entry];
+    if (prev != kNone) {
+      next_[prev] = next;
+    } else {
+      head_ = next;
+    }
+    if (next != kNone) {
+      prev_[next] = prev;
+    } else {
+      tail_ = prev;
+    }
+    linked_[entry] = false;
+  }
+
+  bool front(size_t *entry) const {
+    if (head_ == kNone) {
+      return false;
+    }
+    *entry = head_;
+    return true;
+  }
+
+private:
+  static constexpr uint16_t kNone = 0xFFFF;
+
+  uint16_t head_ = kNone;
+  uint16_t tail_ = kNone;
+  uint16_t prev_[kSize]{};
+  uint16_t next_[kSize]{};
+  bool linked_[kSize]{};
 };
 
+static int16_t hz_row_ratio_permille_(const HzRowSlot &row, int32_t value) {
+  const int32_t target = row.target > 0 ? row.target : 1;
+  int32_t ratio_permille = (value * 1000) / target;
+  if (ratio_permille < 0) ratio_permille = 0;
+  if (ratio_permille > 1000) ratio_permille = 1000;
+  return static_cast<int16_t>(ratio_permille);
+}
+
+static lv_color_t hz_row_bar_color_(const HzRowSlot &row, int32_t ratio_permille) {
+  lv_color_t color = lv_palette_main(LV_PALETTE_RED);
+  if (row.negative_polarity) {
+    color = lv_palette_main(LV_PALETTE_GREEN);
+    if (ratio_permille >= 900) {
+      color = lv_palette_main(LV_PALETTE_RED);
+    } else if (ratio_permille >= 700) {
+      color = lv_palette_main(LV_PALETTE_AMBER);
+    }
+  } else {
+    if (ratio_permille >= 900) {
+      color = lv_palette_main(LV_PALETTE_GREEN);
+    } else if (ratio_permille >= 700) {
+      color = lv_palette_main(LV_PALETTE_AMBER);
+    }
+  }
+  return color;
+}
+
+// Compact hz rows: one plain object per row whose draw callback paints the name, the value
+// text and the bar from the slot, instead of a row container with two labels and a bar.
+static void compact_hz_row_areas_(const HzRowSlot &row,
+                                  lv_obj_t *obj,
+                                  lv_area_t *name_area,
+                                  lv_area_t *value_area,
+                                  lv_area_t *bar_area) {
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  const lv_coord_t label_h = lv_font_get_line_height(&lv_font_montserrat_14);
+  const lv_coord_t w = lv_area_get_width(&coords);
+  // Text rows center the line vertically; hz rows put it on top of the bar.
+  const lv_coord_t text_y = row.text_only ? coords.y1 + (lv_area_get_height(&coords) - label_h) / 2 : coords.y1;
+
+  if (name_area != nullptr) {
+    lv_area_set(name_area, coords.x1, text_y, coords.x2, text_y + label_h - 1);
+  }
+  if (value_area != nullptr) {
+    const lv_coord_t value_w = w * (row.text_only ? 65 : 55) / 100;
+    lv_area_set(value_area, coords.x2 - value_w + 1, text_y, coords.x2, text_y + label_h - 1);
+  }
+  if (bar_area != nullptr) {
+    lv_area_set(bar_area, coords.x1, coords.y2 - 7, coords.x2, coords.y2);
+  }
+}
+
+static void compact_hz_row_draw_cb_(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  const HzRowSlot *row = static_cast<const HzRowSlot *>(lv_event_get_user_data(e));
+  lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+  if (row == nullptr || draw_ctx == nullptr) {
+    return;
+  }
+
+  lv_area_t name_area;
+  lv_area_t value_area;
+  lv_area_t bar_area;
+  compact_hz_row_areas_(*row, obj, &name_area, &value_area, &bar_area);
+
+  // Text color and font come from the row's shared styles, including the stale state.
+  lv_draw_label_dsc_t label_dsc;
+  lv_draw_label_dsc_init(&label_dsc);
+  lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+  lv_draw_label(draw_ctx, &label_dsc, &name_area, row->label, nullptr);
+  label_dsc.align = LV_TEXT_ALIGN_RIGHT;
+  lv_draw_label(draw_ctx, &label_dsc, &value_area, row->text, nullptr);
+
+  if (row->text_only) {
+    return;
+  }
+
+  lv_draw_rect_dsc_t rect_dsc;
+  lv_draw_rect_dsc_init(&rect_dsc);
+  rect_dsc.radius = 4;
+  rect_dsc.bg_color = kArcBg;
+  lv_draw_rect(draw_ctx, &rect_dsc, &bar_area);
+
+  if (row->ratio_permille > 0) {
+    lv_area_t fill = bar_area;
+    fill.x2 = fill.x1 + (lv_area_get_width(&bar_area) * row->ratio_permille) / 1000 - 1;
+    if (fill.x2 >= fill.x1) {
+      rect_dsc.bg_color = row->has_bar_color ? row->bar_color : kStaleArc;
+      lv_draw_rect(draw_ctx, &rect_dsc, &fill);
+    }
+  }
+}
+
+static lv_obj_t *create_compact_hz_row_(lv_obj_t *parent, HzRowSlot *row, lv_coord_t y, lv_coord_t height) {
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_set_pos(obj, 0, y);
+  lv_obj_set_size(obj, LV_PCT(100), height);
+  lv_obj_add_style(obj, &g_styles.transparent, LV_PART_MAIN);
+  lv_obj_add_style(obj, &g_styles.label, LV_PART_MAIN);
+  lv_obj_add_style(obj, &g_styles.stale_text, LV_PART_MAIN | kStateStale);
+  lv_obj_add_state(obj, kStateStale);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_flag(obj, kFlagLive);
+  lv_obj_add_event_cb(obj, compact_hz_row_draw_cb_, LV_EVENT_DRAW_MAIN, row);
+  return obj;
+}
+
+// Updates a compact row and invalidates only the parts that changed.
+static void update_compact_hz_row_(HzRowSlot *row, const char *text, int16_t ratio_permille, lv_color_t color) {
+  lv_area_t value_area;
+  lv_area_t bar_area;
+  compact_hz_row_areas_(*row, row->compact, nullptr, &value_area, &bar_area);
+
+  if (update_text_buffer_(row->text, row->text_size, text)) {
+    lv_obj_invalidate_area(row->compact, &value_area);
+  }
+  if (row->text_only) {
+    return;
+  }
+  if (ratio_permille != row->ratio_permille || !row->has_bar_color || color.full != row->bar_color.full) {
+    row->ratio_permille = ratio_permille;
+    row->bar_color = color;
+    row->has_bar_color = true;
+    lv_obj_invalidate_area(row->compact, &bar_area);
+  }
+}
+
 static void button_event_cb_(lv_event_t *e) {
   if (lv_event_get_code(e) != LV_EVENT_CLICKED) {
     return;
@@ -508,6 +1101,404 @@ static bool read_line_(File &f, char *out, size_t out_size, bool *out_truncated)
   return got_any;
 }
 
+// Optional "format" object of a gauge or hz row: {"scale", "decimals", "unit", "suffix"}.
+static bool parse_value_format_(JsonVariant v, ValueFormat *out) {
+  *out = ValueFormat{};
+  if (v.isNull()) {
+    return true;
+  }
+  JsonObject f = v.as<JsonObject>();
+  if (f.isNull()) {
+    return false;
+  }
+
+  double scale = 1.0;
+  if (!f["scale"].isNull()) {
+    if (!f["scale"].is<double>() && !f["scale"].is<int32_t>()) return false;
+    scale = f["scale"].as<double>();
+  }
+  uint8_t decimals = 0;
+  if (!f["decimals"].isNull()) {
+    if (!f["decimals"].is<uint8_t>()) return false;
+    decimals = f["decimals"].as<uint8_t>();
+  }
+  if ((!f["unit"].isNull() && !f["unit"].is<const char *>()) ||
+      (!f["suffix"].isNull() && !f["suffix"].is<const char *>())) {
+    return false;
+  }
+  return compileValueFormat(scale, decimals, f["unit"].as<const char *>(), f["suffix"].as<const char *>(), out);
+}
+
+// Text shown for an update: explicit text wins, otherwise the value rendered with the widget's
+// format into `buf`. Returns `text` or `buf`, never nullptr.
+static const char *resolve_text_(const ValueFormat &format, char *buf, size_t buf_size, int32_t value, const char *text) {
+  if (text != nullptr) {
+    return text;
+  }
+  renderValueFormat(format, value, buf, buf_size);
+  return buf;
+}
+
+#if LIVE_DASHBOARD_BENCH_PARSER
+static bool bench_count_sink_(const EventScanner::Event &event, void *user) {
+  // Touch the fields so both parsers do comparable work.
+  uint32_t *acc = static_cast<uint32_t *>(user);
+  *acc += static_cast<uint32_t>(event.value) + (event.id != nullptr ? static_cast<uint8_t>(event.id[0]) : 0U) +
+          (event.text != nullptr ? static_cast<uint8_t>(event.text[0]) : 0U);
+  return true;
+}
+#endif
+
+// Parses every line of `path` repeatedly (no UI updates) with both parsers and prints events/s.
+static void bench_event_parsers_(fs::FS &fs, const char *path) {
+#if LIVE_DASHBOARD_BENCH_PARSER
+  constexpr size_t kCorpusBytes = 16 * 1024;
+  constexpr uint32_t kRunMs = 1000;
+
+  char open_path[72]{};
+  snprintf(open_path, sizeof(open_path), "%s%s", path[0] == '/' ? "" : "/", path);
+  File f = fs.open(open_path, "r");
+  if (!f) {
+    Serial.printf("BENCH parser: cannot open %s\n", open_path);
+    return;
+  }
+
+  char *corpus = static_cast<char *>(malloc(kCorpusBytes));
+  char *scratch = static_cast<char *>(malloc(kEventLineMaxLen + 1));
+  if (corpus == nullptr || scratch == nullptr) {
+    Serial.println("BENCH parser: alloc failed");
+    free(corpus);
+    free(scratch);
+    f.close();
+    return;
+  }
+
+  // Corpus: NUL-separated lines.
+  size_t used = 0;
+  size_t lines = 0;
+  bool truncated = false;
+  while (read_line_(f, scratch, kEventLineMaxLen + 1, &truncated)) {
+    const size_t n = strlen(scratch);
+    if (truncated || n == 0 || used + n + 1 > kCorpusBytes) {
+      continue;
+    }
+    memcpy(corpus + used, scratch, n + 1);
+    used += n + 1;
+    ++lines;
+  }
+  f.close();
+
+  uint32_t acc = 0;
+  EventScanner scanner;
+
+  auto run = [&](const char *label, bool fast) {
+    uint32_t events = 0;
+    uint32_t passes = 0;
+    const uint32_t start = micros();
+    uint32_t elapsed = 0;
+    do {
+      for (size_t off = 0; off < used;) {
+        const char *line = corpus + off;
+        const size_t n = strlen(line);
+        off += n + 1;
+        if (fast) {
+          scanner.begin(&bench_count_sink_, &acc);
+          scanner.feed(line, n);
+          events += scanner.dispatched();
+        } else {
+          // Same zero-copy mode as ingestion, which modifies the input.
+          static StaticJsonDocument<kEventDocSize> doc;
+          memcpy(scratch, line, n + 1);
+          if (deserializeJson(doc, scratch)) {
+            continue;
+          }
+          auto visit = [&](JsonObject obj) {
+            const char *id = obj["id"];
+            const char *text = obj["text"];
+            const EventScanner::Event event{
+                EventScanner::Kind::kItem, id, text, obj["value"].is<int32_t>(), obj["value"].as<int32_t>(), 0};
+            bench_count_sink_(event, &acc);
+            ++events;
+          };
+          JsonVariant root = doc.as<JsonVariant>();
+          if (root.is<JsonArray>()) {
+            for (JsonVariant v : root.as<JsonArray>()) {
+              visit(v.as<JsonObject>());
+            }
+          } else {
+            visit(root.as<JsonObject>());
+          }
+        }
+      }
+      ++passes;
+      elapsed = micros() - start;
+    } while (elapsed < kRunMs * 1000U);
+
+    Serial.printf("BENCH parser %s: %u events in %u passes, %.1f ms, %.0f events/s (%.2f us/event)\n",
+                  label,
+                  static_cast<unsigned>(events),
+                  static_cast<unsigned>(passes),
+                  elapsed / 1000.0f,
+                  events * 1e6f / elapsed,
+                  events > 0 ? elapsed / static_cast<float>(events) : 0.0f);
+  };
+
+  Serial.printf("BENCH parser: %u lines, %u bytes from %s\n",
+                static_cast<unsigned>(lines),
+                static_cast<unsigned>(used),
+                open_path);
+  run("scanner", true);
+  run("arduinojson", false);
+  Serial.printf("BENCH parser: checksum %u\n", static_cast<unsigned>(acc));
+
+  free(corpus);
+  free(scratch);
+#else
+  (void)fs;
+  (void)path;
+#endif
+}
+
+// Draws one gauge over the dashboard with each renderer and prints the redraw time per update.
+static void bench_arc_renderers_() {
+#if LIVE_DASHBOARD_BENCH_ARC
+  constexpr uint32_t kRuns = 50;
+  lv_obj_t *scr = lv_scr_act();
+  for (int pass = 0; pass < 2; ++pass) {
+    const bool masked = pass == 1;
+    lv_obj_t *tile = create_tile_(scr);
+    lv_obj_set_size(tile, 160, 180);
+    lv_obj_center(tile);
+
+    ArcGauge gauge;
+    gauge.create(tile, "bench", 0, 100, true, 0, "", nullptr, nullptr, lv_palette_main(LV_PALETTE_BLUE), nullptr, 0, nullptr,
+                 masked);
+    lv_refr_now(nullptr);
+
+    uint32_t total_us = 0;
+    for (uint32_t i = 0; i < kRuns; ++i) {
+      gauge.show(static_cast<int32_t>(1 + (i * 37) % 99), "", false);
+      const uint32_t start = micros();
+      lv_refr_now(nullptr);
+      total_us += micros() - start;
+    }
+    Serial.printf("BENCH arc %s: %u us/redraw\n", masked ? "mask" : "lv_arc", static_cast<unsigned>(total_us / kRuns));
+
+    lv_obj_del(tile);
+    lv_refr_now(nullptr);
+  }
+#endif
+}
+
+#if LIVE_DASHBOARD_BENCH_HOT
+// The layout before the hot state was split out: hot fields at the end of each row slot, behind
+// its id, label, format, text and LVGL handles.
+struct InterleavedRowSlot_ {
+  HzRowSlot cold;
+  char text[LIVE_DASHBOARD_TEXT_MAX_LEN]; // the value text was inline too
+  uint32_t last_update_ms;
+  int32_t value;
+  bool has_value;
+  bool is_stale;
+};
+
+template <size_t N>
+struct HotBench_ {
+  InterleavedRowSlot_ rows[N];
+  WidgetHotState<N> hot;
+  StaleList<N> list;
+};
+
+template <size_t N>
+static void bench_hot_state_n_(uint32_t caps, const char *where) {
+  using Hot = WidgetHotState<N>;
+  constexpr uint32_t kScanRuns = 200;
+  constexpr uint32_t kPublishes = 20000;
+  constexpr uint32_t kTimeoutMs = 5000;
+
+  void *mem = heap_caps_malloc(sizeof(HotBench_<N>), caps);
+  if (mem == nullptr) {
+    Serial.printf("BENCH hot n=%u %s: no memory for %u bytes\n", static_cast<unsigned>(N), where,
+                  static_cast<unsigned>(sizeof(HotBench_<N>)));
+    return;
+  }
+  HotBench_<N> *b = new (mem) HotBench_<N>();
+  const uint32_t now = millis();
+  for (size_t i = 0; i < N; ++i) {
+    b->rows[i].cold.used = true;
+    b->rows[i].last_update_ms = now;
+    b->rows[i].has_value = true;
+    b->rows[i].is_stale = false;
+    b->hot.flags[i] = Hot::kLive | Hot::kHasValue;
+    b->hot.last_update_ms[i] = now;
+    b->list.moveToBack(i);
+  }
+
+  // Full stale scan, as tick() did before the deadline list: nothing expires.
+  volatile uint32_t sink = 0;
+  uint32_t start = micros();
+  for (uint32_t r = 0; r < kScanRuns; ++r) {
+    uint32_t expired = 0;
+    for (size_t i = 0; i < N; ++i) {
+      const InterleavedRowSlot_ &row = b->rows[i];
+      if (row.cold.used && !row.is_stale && (!row.has_value || now - row.last_update_ms > kTimeoutMs)) ++expired;
+    }
+    sink = sink + expired;
+  }
+  const uint32_t scan_aos_us = micros() - start;
+
+  start = micros();
+  for (uint32_t r = 0; r < kScanRuns; ++r) {
+    uint32_t expired = 0;
+    for (size_t i = 0; i < N; ++i) {
+      const uint8_t f = b->hot.flags[i];
+      if ((f & (Hot::kLive | Hot::kStale)) == Hot::kLive &&
+          ((f & Hot::kHasValue) == 0 || now - b->hot.last_update_ms[i] > kTimeoutMs)) {
+        ++expired;
+      }
+    }
+    sink = sink + expired;
+  }
+  const uint32_t scan_soa_us = micros() - start;
+
+  // tick() with the deadline list when nothing is due: one look at the front.
+  start = micros();
+  for (uint32_t r = 0; r < kScanRuns * N; ++r) {
+    size_t front = 0;
+    if (b->list.front(&front) && static_cast<int32_t>(b->hot.last_update_ms[front] + kTimeoutMs + 1 - now) <= 0) {
+      sink = sink + 1;
+    }
+  }
+  const uint32_t tick_idle_us = micros() - start;
+
+  // Hot part of a publish at scattered widgets.
+  start = micros();
+  for (uint32_t k = 0; k < kPublishes; ++k) {
+    InterleavedRowSlot_ &row = b->rows[(k * 7919U) % N];
+    const bool was_stale = row.is_stale;
+    row.last_update_ms = now;
+    row.value = static_cast<int32_t>(k);
+    row.has_value = true;
+    row.is_stale = false;
+    sink = sink + (was_stale ? 1U : 0U);
+  }
+  const uint32_t publish_aos_us = micros() - start;
+
+  start = micros();
+  for (uint32_t k = 0; k < kPublishes; ++k) {
+    const size_t i = (k * 7919U) % N;
+    const uint8_t f = b->hot.flags[i];
+    b->hot.flags[i] = static_cast<uint8_t>((f & ~Hot::kStale) | Hot::kHasValue);
+    b->hot.value[i] = static_cast<int32_t>(k);
+    b->hot.last_update_ms[i] = now;
+    b->list.moveToBack(i);
+    sink = sink + ((f & Hot::kStale) != 0 ? 1U : 0U);
+  }
+  const uint32_t publish_soa_us = micros() - start;
+
+  // tick() when every widget expires at once: pop and flag each one.
+  start = micros();
+  size_t front = 0;
+  while (b->list.front(&front)) {
+    b->list.remove(front);
+    b->hot.flags[front] |= Hot::kStale;
+  }
+  const uint32_t expire_us = micros() - start;
+  (void)sink;
+
+  const uint64_t scans = static_cast<uint64_t>(kScanRuns) * N;
+  Serial.printf("BENCH hot n=%u %s: scan ns/widget aos=%u soa=%u, tick(list) idle=%u ns expire=%u ns/widget, "
+                "publish ns aos=%u soa+list=%u\n",
+                static_cast<unsigned>(N),
+                where,
+                static_cast<unsigned>(scan_aos_us * 1000ULL / scans),
+                static_cast<unsigned>(scan_soa_us * 1000ULL / scans),
+                static_cast<unsigned>(tick_idle_us * 1000ULL / scans),
+                static_cast<unsigned>(expire_us * 1000ULL / N),
+                static_cast<unsigned>(publish_aos_us * 1000ULL / kPublishes),
+                static_cast<unsigned>(publish_soa_us * 1000ULL / kPublishes));
+
+  b->~HotBench_<N>();
+  heap_caps_free(mem);
+}
+#endif
+
+// Synthetic widget state only (no LVGL objects), in internal RAM and PSRAM.
+static void bench_hot_state_() {
+#if LIVE_DASHBOARD_BENCH_HOT
+  constexpr uint32_t kInternal = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+  bench_hot_state_n_<24>(kInternal, "internal");
+  bench_hot_state_n_<128>(kInternal, "internal");
+  bench_hot_state_n_<512>(kInternal, "internal");
+  bench_hot_state_n_<24>(MALLOC_CAP_SPIRAM, "psram");
+  bench_hot_state_n_<128>(MALLOC_CAP_SPIRAM, "psram");
+  bench_hot_state_n_<512>(MALLOC_CAP_SPIRAM, "psram");
+#endif
+}
+
+#if LIVE_DASHBOARD_BENCH_STYLES
+static uint32_t count_objects_(lv_obj_t *obj) {
+  uint32_t count = 1;
+  const uint32_t children = lv_obj_get_child_cnt(obj);
+  for (uint32_t i = 0; i < children; ++i) {
+    count += count_objects_(lv_obj_get_child(obj, i));
+  }
+  return count;
+}
+
+static lv_obj_t *find_live_(lv_obj_t *obj) {
+  const uint32_t children = lv_obj_get_child_cnt(obj);
+  for (uint32_t i = 0; i < children; ++i) {
+    lv_obj_t *child = lv_obj_get_child(obj, i);
+    if (lv_obj_has_flag(child, kFlagLive) && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+      return child;
+    }
+    lv_obj_t *found = find_live_(child);
+    if (found != nullptr) {
+      return found;
+    }
+  }
+  return nullptr;
+}
+
+// Prints the heap taken by the dashboard build and how long a full restyle and redraw take.
+static void bench_styles_(lv_obj_t *scr, uint32_t heap_before, uint32_t build_us) {
+  const uint32_t heap_after = ESP.getFreeHeap();
+
+  uint32_t start = micros();
+  lv_obj_refresh_style(scr, LV_PART_ANY, LV_STYLE_PROP_ANY);
+  lv_obj_update_layout(scr);
+  const uint32_t restyle_us = micros() - start;
+
+  start = micros();
+  lv_obj_invalidate(scr);
+  lv_refr_now(nullptr);
+  const uint32_t redraw_us = micros() - start;
+
+  // Redraw of one live widget's area (what a single value update costs).
+  constexpr uint32_t kUpdateRuns = 20;
+  uint32_t update_us = 0;
+  lv_obj_t *live = find_live_(scr);
+  if (live != nullptr) {
+    start = micros();
+    for (uint32_t i = 0; i < kUpdateRuns; ++i) {
+      lv_obj_invalidate(live);
+      lv_refr_now(nullptr);
+    }
+    update_us = (micros() - start) / kUpdateRuns;
+  }
+
+  Serial.printf("BENCH styles: %u objects, build %u us, heap %u bytes, restyle+layout %u us, full redraw %u us, "
+                "update redraw %u us\n",
+                static_cast<unsigned>(count_objects_(scr)),
+                static_cast<unsigned>(build_us),
+                static_cast<unsigned>(heap_before - heap_after),
+                static_cast<unsigned>(restyle_us),
+                static_cast<unsigned>(redraw_us),
+                static_cast<unsigned>(update_us));
+}
+#endif
+
 } // namespace
 
 class LiveDashboardImpl {
@@ -520,12 +1511,21 @@ public:
              char lvgl_drive_letter,
              const LiveDashboardOptions &options);
   void tick();
+  uint32_t msUntilNextTick() const;
 
   bool publishGauge(const char *gauge_id, int32_t value, const char *text);
+  bool bindToCurrentTask();
+  LiveDashboardUpdateStats updateStats() const;
+  size_t widgetCount() const { return gauge_count_ + hz_row_count_; }
+  const char *widgetId(size_t index) const;
   bool ingestLine(char *line);
   bool ingestEventLine(char *line);
+  void beginEventStream();
+  void feedEventStream(const char *data, size_t len);
+  bool endEventStream(char *buffered_line);
   bool onAction(const char *action_id, LiveDashboard::ActionCallback cb, void *user);
   const char *robotName() const { return robot_name_; }
+  uint32_t configHash() const { return config_hash_; }
   bool demo_replay() const { return demo_replay_; }
   uint32_t demo_frame_index() const { return demo_frame_index_; }
   uint32_t demo_cycle() const { return demo_cycle_; }
@@ -536,10 +1536,31 @@ private:
   HzRowSlot *find_hz_row_(const char *row_id);
 
   void stop_demo_replay_(const char *reason);
-  bool ingestEventLineInternal_(char *line);
+  bool ingestEventLineInternal_(EventScanner &scanner, JsonDocument &doc, char *line);
+  bool ingestEventLineJson_(JsonDocument &doc, char *line, size_t skip_items, size_t *applied);
+  bool applyEvent_(const char *id, const char *text, bool has_value, int32_t value);
+  void publishGaugeSlot_(GaugeSlot *slot, int32_t value, const char *text);
+  bool publishHzRow_(HzRowSlot *row, int32_t value, const char *text);
+  void applyHzRow_(HzRowSlot *row, int32_t value, const char *text);
+  bool deferUpdate_(QueuedUpdate::Kind kind, size_t index, int32_t value, const char *text);
+  void drainUpdates_();
+  bool staleDue_(size_t entry, uint32_t now, uint32_t *due_ms) const;
+  bool markFresh_(size_t widget, int32_t value);
+#if LIVE_DASHBOARD_BENCH_HOT
+  void bench_live_hot_path_();
+#endif
+  void markHzRowStale_(HzRowSlot *row);
+  bool onForeignTask_() const { return owner_task_ != nullptr && xTaskGetCurrentTaskHandle() != owner_task_; }
+  bool applySnapshotBegin_(const char *cfg);
+  bool applySnapshotItem_(size_t index, const char *text, bool has_value, int32_t value);
+  void compute_config_hash_();
+  bool bake_static_background_(lv_obj_t *scr);
+  static bool scanned_event_sink_(const EventScanner::Event &event, void *user);
 
   bool load_and_build_(LiveDashboard &api, fs::FS &fs, const char *config_path);
   bool build_from_json_(LiveDashboard &api, JsonObject root);
+  bool alloc_text_pool_(JsonObject root);
+  char *take_text_buf_(size_t len);
 
   uint16_t screen_width_ = 0;
   uint16_t screen_height_ = 0;
@@ -550,6 +1571,15 @@ private:
   uint32_t stale_timeout_ms_ = 5000;
   lv_color_t background_color_ = lv_color_hex(0x0B1220);
   bool dark_theme_ = true;
+  bool static_background_ = false;
+  uint8_t *static_bg_buf_ = nullptr; // PSRAM snapshot shown by the background image
+  lv_img_dsc_t static_bg_dsc_{};
+
+  // Value label texts of all widgets, sized from the config in one allocation per build.
+  size_t text_max_len_ = LIVE_DASHBOARD_TEXT_MAX_LEN - 1;
+  char *text_pool_ = nullptr;
+  size_t text_pool_size_ = 0;
+  size_t text_pool_used_ = 0;
 
   char robot_name_[32]{};
   char splash_path_[64]{};
@@ -576,6 +1606,29 @@ private:
   ButtonSlot buttons_[LIVE_DASHBOARD_MAX_BUTTONS]{};
   size_t button_count_ = 0;
 
+  uint32_t config_hash_ = 0;
+
+  WidgetHotState<kWidgetSlots> hot_{};
+  StaleList<kWidgetSlots> stale_list_{};
+
+  EventScanner scanner_{};
+  EventScanner stream_scanner_{};
+
+  // ArduinoJson fallback documents: external input and the demo replay in tick() can run on
+  // different tasks after bindToCurrentTask(), so they do not share parser state.
+  StaticJsonDocument<kEventDocSize> event_doc_;
+  EventScanner demo_scanner_{};
+  StaticJsonDocument<kEventDocSize> demo_doc_;
+
+  // Cross-task updates (bindToCurrentTask()).
+  TaskHandle_t owner_task_ = nullptr;
+  UpdateQueue *updates_ = nullptr;
+  std::atomic<uint32_t> updates_queued_{0};
+  std::atomic<uint32_t> updates_dropped_{0};
+  uint32_t updates_applied_ = 0;
+  uint32_t updates_max_depth_ = 0;
+  std::atomic<const char *> demo_stop_reason_{nullptr};
+
   lv_obj_t *grid_ = nullptr;
   lv_coord_t col_dsc_[LIVE_DASHBOARD_MAX_TILES + 1]{};
   lv_coord_t row_dsc_[LIVE_DASHBOARD_MAX_TILES + 1]{};
@@ -598,6 +1651,7 @@ bool LiveDashboardImpl::begin(LiveDashboard &api,
   robot_name_[0] = '\0';
   splash_path_[0] = '\0';
   splash_duration_ms_ = 0;
+  static_background_ = false;
   tile_count_ = 0;
   gauge_count_ = 0;
   hz_row_count_ = 0;
@@ -628,34 +1682,42 @@ bool LiveDashboardImpl::begin(LiveDashboard &api,
   }
   demo_file_ = File();
   demo_line_[0] = '\0';
-
-  return load_and_build_(api, fs, config_path);
+  hot_ = WidgetHotState<kWidgetSlots>{};
+  stale_list_.reset();
+
+  const bool ok = load_and_build_(api, fs, config_path);
+  bench_event_parsers_(fs, demo_path_);
+  bench_arc_renderers_();
+  bench_hot_state_();
+#if LIVE_DASHBOARD_BENCH_HOT
+  if (ok) {
+    bench_live_hot_path_();
+  }
+#endif
+  return ok;
 }
 
 void LiveDashboardImpl::tick() {
+  drainUpdates_();
+
+  // Only widgets whose deadline passed are touched; the list front is the oldest update.
   uint32_t now = millis();
-  for (size_t i = 0; i < gauge_count_; ++i) {
-    if (gauges_[i].used) {
-      gauges_[i].gauge.tick(now);
+  size_t entry = 0;
+  uint32_t due = 0;
+  while (stale_list_.front(&entry)) {
+    const bool pending = staleDue_(entry, now, &due);
+    if (pending && static_cast<int32_t>(due - now) > 0) {
+      break;
     }
-  }
-
-  for (size_t i = 0; i < hz_row_count_; ++i) {
-    HzRowSlot &row = hz_rows_[i];
-    if (!row.used || row.value_label == nullptr || row.name_label == nullptr) {
+    stale_list_.remove(entry);
+    if (!pending) {
       continue;
     }
-
-    const bool stale = !row.has_value || (stale_timeout_ms_ > 0 && (now - row.last_update_ms > stale_timeout_ms_));
-    if (stale && !row.is_stale) {
-      row.is_stale = true;
-      lv_obj_set_style_text_color(row.name_label, kTextSecondary, LV_PART_MAIN);
-      lv_obj_set_style_text_color(row.value_label, kTextSecondary, LV_PART_MAIN);
-      lv_label_set_text(row.value_label, row.text_only ? "-" : "--");
-      if (row.bar != nullptr) {
-        lv_bar_set_value(row.bar, 0, LV_ANIM_OFF);
-        lv_obj_set_style_bg_color(row.bar, kStaleArc, LV_PART_INDICATOR);
-      }
+    hot_.flags[entry] |= WidgetHotState<kWidgetSlots>::kStale;
+    if (entry < kRowWidgetBase) {
+      gauges_[entry].gauge.showStale();
+    } else {
+      markHzRowStale_(&hz_rows_[entry - kRowWidgetBase]);
     }
   }
 
@@ -692,71 +1754,275 @@ void LiveDashboardImpl::tick() {
       continue;
     }
 
-    if (wrapped) {
-      ++demo_cycle_;
-      demo_frame_index_ = 0;
+    if (wrapped) {
+      ++demo_cycle_;
+      demo_frame_index_ = 0;
+    }
+
+    ingestEventLineInternal_(demo_scanner_, demo_doc_, line);
+    ++demo_frame_index_;
+    break;
+  }
+}
+
+uint32_t LiveDashboardImpl::msUntilNextTick() const {
+  const uint32_t now = millis();
+  uint32_t best = UINT32_MAX;
+  auto consider = [&](uint32_t due_ms) {
+    const int32_t left = static_cast<int32_t>(due_ms - now);
+    const uint32_t wait = left > 0 ? static_cast<uint32_t>(left) : 0U;
+    if (wait < best) best = wait;
+  };
+
+  size_t entry = 0;
+  uint32_t due = 0;
+  if (stale_list_.front(&entry)) {
+    // Entries that cannot go stale (no timeout) are dropped by the next tick().
+    consider(staleDue_(entry, now, &due) ? due : now);
+  }
+  if (demo_replay_ && demo_file_ && demo_period_ms_ > 0) {
+    consider(demo_last_ms_ + demo_period_ms_);
+  }
+  return best;
+}
+
+bool LiveDashboardImpl::publishGauge(const char *gauge_id, int32_t value, const char *text) {
+  if (GaugeSlot *slot = find_gauge_(gauge_id)) {
+    publishGaugeSlot_(slot, value, text);
+    return true;
+  }
+
+  HzRowSlot *row = find_hz_row_(gauge_id);
+  if (row == nullptr) {
+    return false;
+  }
+  return publishHzRow_(row, value, text);
+}
+
+void LiveDashboardImpl::publishGaugeSlot_(GaugeSlot *slot, int32_t value, const char *text) {
+  char scratch[LIVE_DASHBOARD_TEXT_MAX_LEN];
+  text = resolve_text_(slot->format, scratch, sizeof(scratch), value, text);
+  const size_t index = static_cast<size_t>(slot - gauges_);
+  if ((hot_.flags[index] & WidgetHotState<kWidgetSlots>::kLive) == 0 ||
+      deferUpdate_(QueuedUpdate::kGauge, index, value, text)) {
+    return;
+  }
+  slot->gauge.show(value, text, markFresh_(index, value));
+}
+
+bool LiveDashboardImpl::publishHzRow_(HzRowSlot *row, int32_t value, const char *text) {
+  if ((hot_.flags[kRowWidgetBase + static_cast<size_t>(row - hz_rows_)] & WidgetHotState<kWidgetSlots>::kLive) == 0) {
+    return false;
+  }
+
+  char scratch[LIVE_DASHBOARD_TEXT_MAX_LEN];
+  text = resolve_text_(row->format, scratch, sizeof(scratch), value, text);
+  if (!deferUpdate_(QueuedUpdate::kHzRow, static_cast<size_t>(row - hz_rows_), value, text)) {
+    applyHzRow_(row, value, text);
+  }
+  return true;
+}
+
+void LiveDashboardImpl::applyHzRow_(HzRowSlot *row, int32_t value, const char *text) {
+  const bool was_stale = markFresh_(kRowWidgetBase + static_cast<size_t>(row - hz_rows_), value);
+
+  if (row->compact != nullptr) {
+    if (was_stale) {
+      lv_obj_clear_state(row->compact, kStateStale);
+    }
+    int16_t ratio_permille = 0;
+    lv_color_t color = kStaleArc;
+    if (!row->text_only) {
+      ratio_permille = hz_row_ratio_permille_(*row, value);
+      color = hz_row_bar_color_(*row, ratio_permille);
+    }
+    update_compact_hz_row_(row, text, ratio_permille, color);
+    return;
+  }
+
+  if (was_stale) {
+    lv_obj_clear_state(row->name_label, kStateStale);
+    lv_obj_clear_state(row->value_label, kStateStale);
+    if (row->bar != nullptr) {
+      lv_obj_clear_state(row->bar, kStateStale);
+    }
+  }
+  if (row->text_only) {
+    // LV_LABEL_LONG_DOT writes the dots into the label text, so text rows keep an LVGL-owned
+    // copy; it is only replaced when the text changes.
+    if (strcmp(lv_label_get_text(row->value_label), text) != 0) {
+      lv_label_set_text(row->value_label, text);
+    }
+  } else if (update_text_buffer_(row->text, row->text_size, text) || was_stale) {
+    lv_label_set_text_static(row->value_label, row->text);
+  }
+
+  if (row->text_only) {
+    return;
+  }
+
+  const int16_t ratio_permille = hz_row_ratio_permille_(*row, value);
+  const lv_color_t color = hz_row_bar_color_(*row, ratio_permille);
+
+  lv_bar_set_value(row->bar, ratio_permille, LV_ANIM_OFF);
+  if (!row->has_bar_color || color.full != row->bar_color.full) {
+    lv_obj_set_style_bg_color(row->bar, color, LV_PART_INDICATOR);
+    row->bar_color = color;
+    row->has_bar_color = true;
+  }
+}
+
+bool LiveDashboardImpl::deferUpdate_(QueuedUpdate::Kind kind, size_t index, int32_t value, const char *text) {
+  if (!onForeignTask_()) {
+    return false;
+  }
+  QueuedUpdate update;
+  update.kind = kind;
+  update.index = static_cast<uint16_t>(index);
+  update.value = value;
+  copy_cstr(update.text, sizeof(update.text), text);
+  if (updates_->push(update)) {
+    updates_queued_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    updates_dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+void LiveDashboardImpl::drainUpdates_() {
+  if (updates_ == nullptr) {
+    return;
+  }
+  const size_t depth = updates_->depth();
+  if (depth > updates_max_depth_) {
+    updates_max_depth_ = static_cast<uint32_t>(depth);
+  }
+
+  QueuedUpdate update;
+  while (updates_->pop(&update)) {
+    if (update.kind == QueuedUpdate::kGauge) {
+      gauges_[update.index].gauge.show(update.value, update.text, markFresh_(update.index, update.value));
+    } else {
+      applyHzRow_(&hz_rows_[update.index], update.value, update.text);
     }
+    ++updates_applied_;
+  }
 
-    ingestEventLineInternal_(line);
-    ++demo_frame_index_;
-    break;
+  const char *reason = demo_stop_reason_.exchange(nullptr, std::memory_order_acquire);
+  if (reason != nullptr) {
+    stop_demo_replay_(reason);
   }
 }
 
-bool LiveDashboardImpl::publishGauge(const char *gauge_id, int32_t value, const char *text) {
-  if (GaugeSlot *slot = find_gauge_(gauge_id)) {
-    slot->gauge.publish(value, text, millis());
+bool LiveDashboardImpl::staleDue_(size_t entry, uint32_t now, uint32_t *due_ms) const {
+  using Hot = WidgetHotState<kWidgetSlots>;
+  const uint8_t flags = hot_.flags[entry];
+  if ((flags & (Hot::kLive | Hot::kStale)) != Hot::kLive) {
+    return false;
+  }
+  if ((flags & Hot::kHasValue) == 0) {
+    *due_ms = now;
     return true;
   }
-
-  HzRowSlot *row = find_hz_row_(gauge_id);
-  if (row == nullptr || row->value_label == nullptr || row->name_label == nullptr) {
+  if (stale_timeout_ms_ == 0) {
     return false;
   }
+  *due_ms = hot_.last_update_ms[entry] + stale_timeout_ms_ + 1;
+  return true;
+}
 
-  row->last_update_ms = millis();
-  row->has_value = true;
-  row->is_stale = false;
+// Records a publish and returns whether the widget was showing its stale placeholder.
+bool LiveDashboardImpl::markFresh_(size_t widget, int32_t value) {
+  using Hot = WidgetHotState<kWidgetSlots>;
+  const uint8_t flags = hot_.flags[widget];
+  hot_.flags[widget] = static_cast<uint8_t>((flags & ~Hot::kStale) | Hot::kHasValue);
+  hot_.value[widget] = value;
+  hot_.last_update_ms[widget] = millis();
+  stale_list_.moveToBack(widget);
+  return (flags & Hot::kStale) != 0;
+}
 
-  lv_obj_set_style_text_color(row->name_label, kTextPrimary, LV_PART_MAIN);
-  lv_obj_set_style_text_color(row->value_label, kTextPrimary, LV_PART_MAIN);
-  lv_label_set_text(row->value_label, text != nullptr ? text : "-");
+#if LIVE_DASHBOARD_BENCH_HOT
+// tick() with nothing due and a publish (including its LVGL label / bar update) on this config.
+void LiveDashboardImpl::bench_live_hot_path_() {
+  constexpr uint32_t kTicks = 1000;
+  constexpr uint32_t kPublishes = 100;
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < kTicks; ++i) {
+    tick();
+  }
+  const uint32_t tick_us = micros() - start;
+
+  uint32_t publish_us = 0;
+  const size_t widgets = widgetCount();
+  if (widgets > 0) {
+    start = micros();
+    for (uint32_t i = 0; i < kPublishes; ++i) {
+      publishGauge(widgetId(i % widgets), static_cast<int32_t>(i), nullptr);
+    }
+    publish_us = micros() - start;
+  }
+  Serial.printf("BENCH hot live: %u widgets, tick %u ns, publish %u ns\n",
+                static_cast<unsigned>(widgets),
+                static_cast<unsigned>(tick_us * 1000ULL / kTicks),
+                static_cast<unsigned>(publish_us * 1000ULL / kPublishes));
+}
+#endif
 
+void LiveDashboardImpl::markHzRowStale_(HzRowSlot *row) {
+  if (row->compact != nullptr) {
+    lv_obj_add_state(row->compact, kStateStale);
+    update_compact_hz_row_(row, row->text_only ? "-" : "--", 0, row->bar_color);
+    return;
+  }
+  lv_obj_add_state(row->name_label, kStateStale);
+  lv_obj_add_state(row->value_label, kStateStale);
   if (row->text_only) {
-    return true;
+    lv_label_set_text(row->value_label, "-");
+  } else {
+    lv_label_set_text_static(row->value_label, "--");
   }
-
-  if (row->bar == nullptr) {
-    return false;
+  if (row->bar != nullptr) {
+    lv_bar_set_value(row->bar, 0, LV_ANIM_OFF);
+    lv_obj_add_state(row->bar, kStateStale);
   }
+}
 
-  const int32_t target = row->target > 0 ? row->target : 1;
-  int32_t ratio_permille = (value * 1000) / target;
-  if (ratio_permille < 0) ratio_permille = 0;
-  if (ratio_permille > 1000) ratio_permille = 1000;
-
-  lv_color_t color = lv_palette_main(LV_PALETTE_RED);
-  if (row->negative_polarity) {
-    color = lv_palette_main(LV_PALETTE_GREEN);
-    if (ratio_permille >= 900) {
-      color = lv_palette_main(LV_PALETTE_RED);
-    } else if (ratio_permille >= 700) {
-      color = lv_palette_main(LV_PALETTE_AMBER);
-    }
-  } else {
-    if (ratio_permille >= 900) {
-      color = lv_palette_main(LV_PALETTE_GREEN);
-    } else if (ratio_permille >= 700) {
-      color = lv_palette_main(LV_PALETTE_AMBER);
+bool LiveDashboardImpl::bindToCurrentTask() {
+  if (updates_ == nullptr) {
+    updates_ = new (std::nothrow) UpdateQueue();
+    if (updates_ == nullptr) {
+      Serial.println("LiveDashboard: update queue allocation failed");
+      return false;
     }
   }
-
-  lv_bar_set_value(row->bar, ratio_permille, LV_ANIM_OFF);
-  lv_obj_set_style_bg_color(row->bar, color, LV_PART_INDICATOR);
+  owner_task_ = xTaskGetCurrentTaskHandle();
   return true;
 }
 
+LiveDashboardUpdateStats LiveDashboardImpl::updateStats() const {
+  LiveDashboardUpdateStats stats;
+  stats.queued = updates_queued_.load(std::memory_order_relaxed);
+  stats.dropped = updates_dropped_.load(std::memory_order_relaxed);
+  stats.applied = updates_applied_;
+  stats.max_depth = updates_max_depth_;
+  return stats;
+}
+
+const char *LiveDashboardImpl::widgetId(size_t index) const {
+  if (index < gauge_count_) {
+    return gauges_[index].id;
+  }
+  index -= gauge_count_;
+  return index < hz_row_count_ ? hz_rows_[index].id : nullptr;
+}
+
 void LiveDashboardImpl::stop_demo_replay_(const char *reason) {
+  if (onForeignTask_()) {
+    // The demo file belongs to tick(); let it stop there.
+    demo_stop_reason_.store(reason, std::memory_order_release);
+    return;
+  }
   if (!demo_replay_) {
     return;
   }
@@ -796,7 +2062,7 @@ bool LiveDashboardImpl::ingestLine(char *line) {
   }
 
   if (line[0] == '{' || line[0] == '[') {
-    const bool ok = ingestEventLineInternal_(line);
+    const bool ok = ingestEventLineInternal_(scanner_, event_doc_, line);
     if (ok) {
       stop_demo_replay_("external JSON");
     }
@@ -836,14 +2102,49 @@ bool LiveDashboardImpl::ingestEventLine(char *line) {
     return false;
   }
 
-  const bool ok = ingestEventLineInternal_(p);
+  const bool ok = ingestEventLineInternal_(scanner_, event_doc_, p);
   if (ok) {
     stop_demo_replay_("external JSON");
   }
   return ok;
 }
 
-bool LiveDashboardImpl::ingestEventLineInternal_(char *line) {
+void LiveDashboardImpl::beginEventStream() { stream_scanner_.begin(&LiveDashboardImpl::scanned_event_sink_, this); }
+
+void LiveDashboardImpl::feedEventStream(const char *data, size_t len) {
+  if (data == nullptr || len == 0) {
+    return;
+  }
+  stream_scanner_.feed(data, len);
+  if (stream_scanner_.applied() > 0) {
+    stop_demo_replay_("external JSON");
+  }
+}
+
+bool LiveDashboardImpl::endEventStream(char *buffered_line) {
+  const EventScanner::Status status = stream_scanner_.status();
+  if (status == EventScanner::Status::kDone) {
+    return stream_scanner_.applied() > 0;
+  }
+
+  // The fallback document holds any line up to kEventLineMaxLen; longer ones keep what the
+  // scanner applied.
+  if (buffered_line != nullptr && strlen(buffered_line) <= kEventLineMaxLen) {
+    size_t applied = stream_scanner_.applied();
+    const bool ok = ingestEventLineJson_(event_doc_, buffered_line, stream_scanner_.dispatched(), &applied);
+    if (ok && applied > 0) {
+      stop_demo_replay_("external JSON");
+    }
+    return ok && applied > 0;
+  }
+
+  Serial.printf("EVENT: stream %s after %u items (too long for fallback)\n",
+                status == EventScanner::Status::kNeedMore ? "incomplete" : "unsupported",
+                static_cast<unsigned>(stream_scanner_.dispatched()));
+  return stream_scanner_.applied() > 0;
+}
+
+bool LiveDashboardImpl::ingestEventLineInternal_(EventScanner &scanner, JsonDocument &doc, char *line) {
   if (line == nullptr) {
     Serial.println("EVENT: line is null");
     return false;
@@ -862,7 +2163,20 @@ bool LiveDashboardImpl::ingestEventLineInternal_(char *line) {
     return false;
   }
 
-  static StaticJsonDocument<2048> doc;
+  // Fast path: single pass over the line, each item applied as soon as it closes.
+  scanner.begin(&LiveDashboardImpl::scanned_event_sink_, this);
+  if (scanner.feed(line, len) == EventScanner::Status::kDone) {
+    return scanner.applied() > 0;
+  }
+
+  // Anything the scanner does not handle (or malformed input) goes through ArduinoJson, which
+  // also produces the diagnostics. Items the scanner already applied are not applied twice.
+  size_t applied = scanner.applied();
+  const bool ok = ingestEventLineJson_(doc, line, scanner.dispatched(), &applied);
+  return ok && applied > 0;
+}
+
+bool LiveDashboardImpl::ingestEventLineJson_(JsonDocument &doc, char *line, size_t skip_items, size_t *applied) {
   doc.clear();
   DeserializationError err = deserializeJson(doc, line);
   if (err) {
@@ -875,71 +2189,261 @@ bool LiveDashboardImpl::ingestEventLineInternal_(char *line) {
       Serial.println("EVENT: item is not an object");
       return false;
     }
-
-    const char *id = obj["id"];
-    const char *text = obj["text"];
-    if (id == nullptr || text == nullptr) {
-      Serial.println("EVENT: missing id/text");
-      return false;
-    }
-
-    GaugeSlot *gauge = find_gauge_(id);
-    HzRowSlot *row = (gauge == nullptr) ? find_hz_row_(id) : nullptr;
-    if (gauge == nullptr && row == nullptr) {
-      Serial.printf("EVENT: unknown id: %s\n", id);
-      return false;
-    }
-
-    int32_t value = 0;
-    if (gauge != nullptr || (row != nullptr && !row->text_only)) {
-      if (!obj["value"].is<int32_t>()) {
-        Serial.println("EVENT: missing/invalid value");
-        return false;
-      }
-      value = obj["value"].as<int32_t>();
-    } else if (obj["value"].is<int32_t>()) {
-      value = obj["value"].as<int32_t>();
-    }
-
-    if (!publishGauge(id, value, text)) {
-      Serial.printf("EVENT: publish failed for id: %s\n", id);
-      return false;
-    }
-
-    return true;
+    const bool has_value = obj["value"].is<int32_t>();
+    return applyEvent_(obj["id"], obj["text"], has_value, has_value ? obj["value"].as<int32_t>() : 0);
   };
 
   JsonVariant root = doc.as<JsonVariant>();
-  size_t applied = 0;
 
   if (root.is<JsonArray>()) {
     JsonArray arr = root.as<JsonArray>();
-    if (arr.size() > kMaxEventsPerLine) {
-      Serial.printf("EVENT: too many items (%u > %u)\n",
-                    static_cast<unsigned>(arr.size()),
-                    static_cast<unsigned>(kMaxEventsPerLine));
-      return false;
-    }
-
+    size_t index = 0;
     for (JsonVariant v : arr) {
+      if (index++ < skip_items) {
+        continue;
+      }
       if (!v.is<JsonObject>()) {
         Serial.println("EVENT: array item is not an object");
         return false;
       }
       if (apply_one(v.as<JsonObject>())) {
-        ++applied;
+        ++*applied;
+      }
+    }
+  } else if (root.is<JsonObject>() && root.containsKey("snap")) {
+    JsonObject snapshot = root.as<JsonObject>();
+    if (!applySnapshotBegin_(snapshot["cfg"])) {
+      return false;
+    }
+    if (!snapshot["snap"].is<JsonArray>()) {
+      Serial.println("EVENT: snap must be an array");
+      return false;
+    }
+
+    size_t index = 0;
+    for (JsonVariant v : snapshot["snap"].as<JsonArray>()) {
+      const size_t i = index++;
+      if (i < skip_items || v.isNull()) {
+        continue;
+      }
+      JsonVariant value = v;
+      const char *text = nullptr;
+      if (v.is<JsonArray>()) {
+        value = v[0];
+        text = v[1];
+      } else if (v.is<const char *>()) {
+        text = v.as<const char *>();
+      } else if (!v.is<int32_t>()) {
+        Serial.printf("EVENT: snapshot[%u] invalid item\n", static_cast<unsigned>(i));
+        continue;
+      }
+      const bool has_value = value.is<int32_t>();
+      if (applySnapshotItem_(i, text, has_value, has_value ? value.as<int32_t>() : 0)) {
+        ++*applied;
       }
     }
   } else if (root.is<JsonObject>()) {
-    if (apply_one(root.as<JsonObject>())) {
-      applied = 1;
+    if (skip_items == 0 && apply_one(root.as<JsonObject>())) {
+      ++*applied;
     }
   } else {
     Serial.println("EVENT: root must be object or array");
     return false;
   }
 
-  return applied > 0;
+  return true;
+}
+
+bool LiveDashboardImpl::scanned_event_sink_(const EventScanner::Event &event, void *user) {
+  LiveDashboardImpl *self = static_cast<LiveDashboardImpl *>(user);
+  switch (event.kind) {
+    case EventScanner::Kind::kItem:
+      return self->applyEvent_(event.id, event.text, event.has_value, event.value);
+    case EventScanner::Kind::kSnapshotBegin:
+      return self->applySnapshotBegin_(event.text);
+    case EventScanner::Kind::kSnapshotItem:
+      return self->applySnapshotItem_(event.index, event.text, event.has_value, event.value);
+  }
+  return false;
+}
+
+bool LiveDashboardImpl::applySnapshotBegin_(const char *cfg) {
+  if (cfg == nullptr) {
+    Serial.println("EVENT: snapshot missing cfg");
+    return false;
+  }
+  char *end = nullptr;
+  const unsigned long hash = strtoul(cfg, &end, 16);
+  if (end == cfg || *end != '\0' || static_cast<uint32_t>(hash) != config_hash_) {
+    Serial.printf("EVENT: snapshot cfg mismatch (got %s, expected %08lx)\n", cfg, static_cast<unsigned long>(config_hash_));
+    return false;
+  }
+  return true;
+}
+
+// Snapshot items address widgets by position: gauges first, then hz_lists rows, both in
+// config order (the same order config_hash_ is computed over).
+bool LiveDashboardImpl::applySnapshotItem_(size_t index, const char *text, bool has_value, int32_t value) {
+  if (text == nullptr && !has_value) {
+    return false; // null: leave the widget untouched
+  }
+
+  if (index < gauge_count_) {
+    GaugeSlot *gauge = &gauges_[index];
+    if (!has_value) {
+      Serial.printf("EVENT: snapshot[%u] missing value\n", static_cast<unsigned>(index));
+      return false;
+    }
+    publishGaugeSlot_(gauge, value, text);
+    return true;
+  }
+
+  const size_t row_index = index - gauge_count_;
+  if (row_index < hz_row_count_) {
+    HzRowSlot *row = &hz_rows_[row_index];
+    if (!has_value && !row->text_only) {
+      Serial.printf("EVENT: snapshot[%u] missing value\n", static_cast<unsigned>(index));
+      return false;
+    }
+    return publishHzRow_(row, has_value ? value : 0, text);
+  }
+
+  if (row_index == hz_row_count_) {
+    Serial.printf("EVENT: snapshot has more items than widgets (%u)\n",
+                  static_cast<unsigned>(gauge_count_ + hz_row_count_));
+  }
+  return false;
+}
+
+// Hides (live) or un-hides every live object below `obj`; static objects are left alone.
+static void set_live_hidden_(lv_obj_t *obj, bool hidden) {
+  const uint32_t children = lv_obj_get_child_cnt(obj);
+  for (uint32_t i = 0; i < children; ++i) {
+    lv_obj_t *child = lv_obj_get_child(obj, i);
+    if (!lv_obj_has_flag(child, kFlagLive)) {
+      set_live_hidden_(child, hidden);
+    } else if (hidden) {
+      lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+    } else {
+      lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN);
+    }
+  }
+}
+
+// After the snapshot: static subtrees are hidden, static parents of live objects stop drawing
+// their own background/border. Returns true if `obj` has live descendants.
+static bool strip_static_(lv_obj_t *obj) {
+  bool any_live = false;
+  const uint32_t children = lv_obj_get_child_cnt(obj);
+  for (uint32_t i = 0; i < children; ++i) {
+    lv_obj_t *child = lv_obj_get_child(obj, i);
+    if (lv_obj_has_flag(child, kFlagLive)) {
+      any_live = true;
+    } else if (strip_static_(child)) {
+      lv_obj_add_style(child, &g_styles.baked, LV_PART_MAIN);
+      any_live = true;
+    } else {
+      lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+    }
+  }
+  return any_live;
+}
+
+// Renders everything that never changes after build (screen and tile backgrounds, borders,
+// titles, min/max labels, text tiles) once into a PSRAM RGB565 image and shows that image
+// behind the live objects. Invalidated areas then redraw one image blit plus the live
+// widgets instead of the whole tile stack. Falls back to the normal tree if PSRAM is short.
+bool LiveDashboardImpl::bake_static_background_(lv_obj_t *scr) {
+  set_live_hidden_(scr, true);
+  lv_obj_update_layout(scr);
+
+  const uint32_t size = lv_snapshot_buf_size_needed(scr, LV_IMG_CF_TRUE_COLOR);
+  static_bg_buf_ = static_cast<uint8_t *>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (static_bg_buf_ == nullptr) {
+    Serial.printf("Static background: no PSRAM for %u bytes, drawing tiles live\n", static_cast<unsigned>(size));
+    set_live_hidden_(scr, false);
+    return false;
+  }
+  if (lv_snapshot_take_to_buf(scr, LV_IMG_CF_TRUE_COLOR, &static_bg_dsc_, static_bg_buf_, size) != LV_RES_OK) {
+    Serial.println("Static background: snapshot failed, drawing tiles live");
+    heap_caps_free(static_bg_buf_);
+    static_bg_buf_ = nullptr;
+    set_live_hidden_(scr, false);
+    return false;
+  }
+
+  set_live_hidden_(scr, false);
+  strip_static_(scr);
+
+  lv_obj_t *img = lv_img_create(scr);
+  lv_img_set_src(img, &static_bg_dsc_);
+  lv_obj_set_pos(img, 0, 0);
+  lv_obj_move_background(img);
+
+  Serial.printf("Static background: %ux%u, %u bytes PSRAM\n",
+                static_cast<unsigned>(static_bg_dsc_.header.w),
+                static_cast<unsigned>(static_bg_dsc_.header.h),
+                static_cast<unsigned>(size));
+  return true;
+}
+
+void LiveDashboardImpl::compute_config_hash_() {
+  // 32-bit FNV-1a over "<id>\n" for every snapshot position.
+  uint32_t hash = 2166136261u;
+  auto mix = [&](const char *id) {
+    for (const char *p = id; *p != '\0'; ++p) {
+      hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    hash = (hash ^ static_cast<uint8_t>('\n')) * 16777619u;
+  };
+  for (size_t i = 0; i < gauge_count_; ++i) {
+    mix(gauges_[i].id);
+  }
+  for (size_t i = 0; i < hz_row_count_; ++i) {
+    mix(hz_rows_[i].id);
+  }
+  config_hash_ = hash;
+  Serial.printf("Config hash: %08lx (snapshot order: %u gauges, %u rows)\n",
+                static_cast<unsigned long>(config_hash_),
+                static_cast<unsigned>(gauge_count_),
+                static_cast<unsigned>(hz_row_count_));
+}
+
+bool LiveDashboardImpl::applyEvent_(const char *id, const char *text, bool has_value, int32_t value) {
+  if (id == nullptr) {
+    Serial.println("EVENT: missing id");
+    return false;
+  }
+
+  GaugeSlot *gauge = find_gauge_(id);
+  HzRowSlot *row = (gauge == nullptr) ? find_hz_row_(id) : nullptr;
+  if (gauge == nullptr && row == nullptr) {
+    Serial.printf("EVENT: unknown id: %s\n", id);
+    return false;
+  }
+
+  if (!has_value) {
+    if (gauge != nullptr || !row->text_only) {
+      Serial.println("EVENT: missing/invalid value");
+      return false;
+    }
+    if (text == nullptr) {
+      Serial.println("EVENT: missing text");
+      return false;
+    }
+    value = 0;
+  }
+
+  if (gauge != nullptr) {
+    publishGaugeSlot_(gauge, value, text);
+    return true;
+  }
+
+  if (!publishHzRow_(row, value, text)) {
+    Serial.printf("EVENT: publish failed for id: %s\n", id);
+    return false;
+  }
+  return true;
 }
 
 bool LiveDashboardImpl::onAction(const char *action_id, LiveDashboard::ActionCallback cb, void *user) {
@@ -1021,7 +2525,76 @@ bool LiveDashboardImpl::load_and_build_(LiveDashboard &api, fs::FS &fs, const ch
     return false;
   }
 
-  return build_from_json_(api, root);
+#if LIVE_DASHBOARD_BENCH_STYLES
+  // Drop the previous screen first so its objects are not counted against the new build.
+  lv_obj_clean(lv_scr_act());
+  const uint32_t heap_before = ESP.getFreeHeap();
+  const uint32_t build_start = micros();
+#endif
+  const bool ok = build_from_json_(api, root);
+#if LIVE_DASHBOARD_BENCH_STYLES
+  if (ok) {
+    bench_styles_(lv_scr_act(), heap_before, micros() - build_start);
+  }
+#endif
+  return ok;
+}
+
+// Sizes the text pool for every widget with a static value text (gauges, hz rows except text
+// rows outside compact lists) from their text_max_len, before any of them is built.
+bool LiveDashboardImpl::alloc_text_pool_(JsonObject root) {
+  size_t total = 0;
+  for (JsonVariant v : root["gauges"].as<JsonArray>()) {
+    const size_t len = widget_text_len_(v.as<JsonObject>(), text_max_len_);
+    if (len == 0) {
+      show_config_error_screen_("Invalid: gauges[].text_max_len");
+      return false;
+    }
+    total += len + 1;
+  }
+  for (JsonVariant v : root["hz_lists"].as<JsonArray>()) {
+    JsonObject list = v.as<JsonObject>();
+    const bool compact = list["compact"] | false;
+    for (JsonVariant row_v : list["rows"].as<JsonArray>()) {
+      JsonObject row = row_v.as<JsonObject>();
+      const size_t len = widget_text_len_(row, text_max_len_);
+      if (len == 0) {
+        show_config_error_screen_("Invalid: hz_lists[].rows[].text_max_len");
+        return false;
+      }
+      const char *type = row["type"];
+      if (compact || type == nullptr || stricmp_(type, "text") != 0) {
+        total += len + 1;
+      }
+    }
+  }
+
+  heap_caps_free(text_pool_);
+  text_pool_ = nullptr;
+  text_pool_size_ = 0;
+  text_pool_used_ = 0;
+  if (total == 0) {
+    return true;
+  }
+  text_pool_ = static_cast<char *>(heap_caps_malloc(total, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  if (text_pool_ == nullptr) {
+    Serial.printf("FATAL: no memory for %u bytes of widget text\n", static_cast<unsigned>(total));
+    show_config_error_screen_("Out of memory: widget text");
+    return false;
+  }
+  memset(text_pool_, 0, total);
+  text_pool_size_ = total;
+  return true;
+}
+
+// Hands out the next len + 1 bytes of the pool, in the order alloc_text_pool_ counted them.
+char *LiveDashboardImpl::take_text_buf_(size_t len) {
+  if (text_pool_ == nullptr || text_pool_used_ + len + 1 > text_pool_size_) {
+    return nullptr;
+  }
+  char *buf = text_pool_ + text_pool_used_;
+  text_pool_used_ += len + 1;
+  return buf;
 }
 
 bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
@@ -1038,7 +2611,13 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
     return false;
   }
   dark_theme_ = ui["dark_theme"].as<bool>();
+  static_background_ = ui["static_background"] | false;
   stale_timeout_ms_ = ui["stale_timeout_ms"].as<uint32_t>();
+  text_max_len_ = widget_text_len_(ui, LIVE_DASHBOARD_TEXT_MAX_LEN - 1);
+  if (text_max_len_ == 0) {
+    show_config_error_screen_("Invalid: ui.text_max_len");
+    return false;
+  }
 
   const char *bg_color = ui["background"];
   if (bg_color != nullptr) {
@@ -1132,8 +2711,18 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
 
   lv_obj_t *scr = lv_scr_act();
   lv_obj_clean(scr);
+  if (static_bg_buf_ != nullptr) {
+    lv_img_cache_invalidate_src(&static_bg_dsc_);
+    heap_caps_free(static_bg_buf_);
+    static_bg_buf_ = nullptr;
+  }
+  // The labels that showed the old pool are gone with the old screen.
+  if (!alloc_text_pool_(root)) {
+    return false;
+  }
   lv_obj_set_style_bg_color(scr, background_color_, LV_PART_MAIN);
   lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
+  init_styles_();
 
   for (uint8_t c = 0; c < cols; ++c) col_dsc_[c] = LV_GRID_FR(1);
   col_dsc_[cols] = LV_GRID_TEMPLATE_LAST;
@@ -1143,10 +2732,7 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
 
   grid_ = lv_obj_create(scr);
   lv_obj_set_size(grid_, screen_width_, screen_height_);
-  lv_obj_set_style_bg_opa(grid_, LV_OPA_TRANSP, LV_PART_MAIN);
-  lv_obj_set_style_border_width(grid_, 0, LV_PART_MAIN);
-  lv_obj_set_style_pad_all(grid_, 0, LV_PART_MAIN);
-  lv_obj_set_style_pad_gap(grid_, 0, LV_PART_MAIN);
+  lv_obj_add_style(grid_, &g_styles.transparent, LV_PART_MAIN);
   lv_obj_clear_flag(grid_, LV_OBJ_FLAG_SCROLLABLE);
   lv_obj_set_layout(grid_, LV_LAYOUT_GRID);
   lv_obj_set_grid_dsc_array(grid_, col_dsc_, row_dsc_);
@@ -1282,6 +2868,21 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
       const char *min_label = g["min_label"];
       const char *max_label = g["max_label"];
       const char *stale_text = g["stale_text"];
+      const size_t text_len = widget_text_len_(g, text_max_len_);
+      char *text_buf = take_text_buf_(text_len);
+      if (text_buf == nullptr) {
+        show_config_error_screen_("Internal: text pool exhausted");
+        return false;
+      }
+
+      const char *renderer = g["renderer"];
+      bool masked = false;
+      if (renderer != nullptr && stricmp_(renderer, "mask") == 0) {
+        masked = true;
+      } else if (renderer != nullptr && stricmp_(renderer, "arc") != 0) {
+        show_config_error_screen_("Invalid: gauges[].renderer");
+        return false;
+      }
 
       lv_color_t accent = lv_palette_main(LV_PALETTE_BLUE);
       const char *accent_str = g["accent"];
@@ -1293,6 +2894,14 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
       GaugeSlot &slot = gauges_[gauge_count_];
       slot.used = true;
       copy_cstr(slot.id, sizeof(slot.id), id);
+      if (!parse_value_format_(g["format"], &slot.format)) {
+        show_config_error_screen_("Invalid: gauges[].format");
+        return false;
+      }
+      char initial_scratch[LIVE_DASHBOARD_TEXT_MAX_LEN];
+      if (publish_initial && !g["initial_text"].is<const char *>()) {
+        initial_text = resolve_text_(slot.format, initial_scratch, sizeof(initial_scratch), initial_value, nullptr);
+      }
 
       slot.stage_count = 0;
       JsonArray stages = g["stages"].as<JsonArray>();
@@ -1332,8 +2941,20 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
                         accent,
                         slot.stage_count > 0 ? slot.stages : nullptr,
                         slot.stage_count,
-                        stale_timeout_ms_,
-                        stale_text);
+                        stale_text,
+                        masked,
+                        text_buf,
+                        text_len + 1);
+
+      // Gauges with an `initial` value start fresh; everything else starts stale.
+      using Hot = WidgetHotState<kWidgetSlots>;
+      hot_.flags[gauge_count_] = static_cast<uint8_t>((slot.gauge.live() ? Hot::kLive : 0) |
+                                                      (publish_initial ? Hot::kHasValue : Hot::kStale));
+      hot_.value[gauge_count_] = initial_value;
+      hot_.last_update_ms[gauge_count_] = millis();
+      if (publish_initial) {
+        stale_list_.moveToBack(gauge_count_);
+      }
 
       ++gauge_count_;
     }
@@ -1373,8 +2994,7 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
 
       lv_obj_t *title = lv_label_create(tile);
       lv_label_set_text(title, tile_title);
-      lv_obj_set_style_text_color(title, kTextPrimary, LV_PART_MAIN);
-      lv_obj_set_style_text_font(title, &lv_font_montserrat_14, LV_PART_MAIN);
+      lv_obj_add_style(title, &g_styles.label, LV_PART_MAIN);
       lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 0);
 
       lv_coord_t height = 95;
@@ -1383,9 +3003,9 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
       lv_obj_t *btn = lv_btn_create(tile);
       lv_obj_set_size(btn, LV_PCT(100), height);
       lv_obj_align(btn, LV_ALIGN_BOTTOM_MID, 0, 0);
+      lv_obj_add_style(btn, &g_styles.button, LV_PART_MAIN);
+      lv_obj_add_flag(btn, kFlagLive);
       lv_obj_set_style_bg_color(btn, color, LV_PART_MAIN);
-      lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
-      lv_obj_set_style_radius(btn, 12, LV_PART_MAIN);
 
       lv_obj_t *lbl = lv_label_create(btn);
       lv_label_set_text(lbl, label);
@@ -1426,25 +3046,21 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
         return false;
       }
 
-      lv_obj_set_layout(tile, LV_LAYOUT_FLEX);
-      lv_obj_set_flex_flow(tile, LV_FLEX_FLOW_COLUMN);
-      lv_obj_set_style_pad_gap(tile, 8, LV_PART_MAIN);
-
       lv_obj_t *lbl_title = lv_label_create(tile);
       lv_label_set_text(lbl_title, title);
-      lv_obj_set_style_text_color(lbl_title, kTextPrimary, LV_PART_MAIN);
-      lv_obj_set_style_text_font(lbl_title, &lv_font_montserrat_16, LV_PART_MAIN);
+      lv_obj_add_style(lbl_title, &g_styles.title, LV_PART_MAIN);
+      lv_obj_align(lbl_title, LV_ALIGN_TOP_LEFT, 0, 0);
+
+      const bool compact = list["compact"] | false;
 
+      // Rows are stacked at fixed offsets; the container is sized to them after the loop.
+      const lv_coord_t label_h = lv_font_get_line_height(&lv_font_montserrat_14);
       lv_obj_t *list_container = lv_obj_create(tile);
+      lv_obj_set_pos(list_container, 0, lv_font_get_line_height(&lv_font_montserrat_16) + kHzListTitleGap);
       lv_obj_set_width(list_container, LV_PCT(100));
-      lv_obj_set_flex_grow(list_container, 1);
-      lv_obj_set_style_bg_opa(list_container, LV_OPA_TRANSP, LV_PART_MAIN);
-      lv_obj_set_style_border_width(list_container, 0, LV_PART_MAIN);
-      lv_obj_set_style_pad_all(list_container, 0, LV_PART_MAIN);
-      lv_obj_set_style_pad_gap(list_container, 6, LV_PART_MAIN);
+      lv_obj_add_style(list_container, &g_styles.transparent, LV_PART_MAIN);
       lv_obj_clear_flag(list_container, LV_OBJ_FLAG_SCROLLABLE);
-      lv_obj_set_layout(list_container, LV_LAYOUT_FLEX);
-      lv_obj_set_flex_flow(list_container, LV_FLEX_FLOW_COLUMN);
+      lv_coord_t row_y = 0;
 
       for (JsonVariant row_v : rows_cfg) {
         if (hz_row_count_ >= LIVE_DASHBOARD_MAX_HZ_ROWS) {
@@ -1492,30 +3108,77 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
           return false;
         }
 
+        ValueFormat format;
+        if (!parse_value_format_(row_cfg["format"], &format)) {
+          show_config_error_screen_("Invalid: hz_lists[].rows[].format");
+          return false;
+        }
+
+        HzRowSlot &slot = hz_rows_[hz_row_count_];
+        slot.used = true;
+        copy_cstr(slot.id, sizeof(slot.id), row_id);
+        copy_cstr(slot.label, sizeof(slot.label), label);
+        slot.text_only = text_only;
+        slot.negative_polarity = negative_polarity;
+        slot.target = target;
+        slot.format = format;
+        slot.name_label = nullptr;
+        slot.value_label = nullptr;
+        slot.bar = nullptr;
+        slot.compact = nullptr;
+        slot.text = nullptr;
+        slot.text_size = 0;
+        if (compact || !text_only) {
+          const size_t text_len = widget_text_len_(row_cfg, text_max_len_);
+          slot.text = take_text_buf_(text_len);
+          slot.text_size = text_len + 1;
+          if (slot.text == nullptr) {
+            show_config_error_screen_("Internal: text pool exhausted");
+            return false;
+          }
+        }
+        slot.ratio_permille = 0;
+        slot.has_bar_color = false;
+        hot_.flags[kRowWidgetBase + hz_row_count_] = WidgetHotState<kWidgetSlots>::kStale;
+
+        const lv_coord_t row_h = text_only ? kHzTextRowHeight : kHzRowHeight;
+        const lv_coord_t y = row_y;
+        row_y += row_h + kHzRowGap;
+
+        if (compact) {
+          copy_cstr(slot.text, slot.text_size, text_only ? "-" : "--");
+          slot.compact = create_compact_hz_row_(list_container, &slot, y, row_h);
+          if (slot.compact != nullptr) {
+            hot_.flags[kRowWidgetBase + hz_row_count_] |= WidgetHotState<kWidgetSlots>::kLive;
+          }
+          ++hz_row_count_;
+          continue;
+        }
+
         lv_obj_t *row = lv_obj_create(list_container);
-        lv_obj_set_width(row, LV_PCT(100));
-        lv_obj_set_height(row, text_only ? 32 : 40);
-        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_border_width(row, 0, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(row, 0, LV_PART_MAIN);
+        lv_obj_set_pos(row, 0, y);
+        lv_obj_set_size(row, LV_PCT(100), row_h);
+        lv_obj_add_style(row, &g_styles.transparent, LV_PART_MAIN);
         lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_flag(row, kFlagLive);
 
         lv_obj_t *lbl_name = lv_label_create(row);
         lv_label_set_text(lbl_name, label);
-        lv_obj_set_style_text_color(lbl_name, kTextSecondary, LV_PART_MAIN);
-        lv_obj_set_style_text_font(lbl_name, &lv_font_montserrat_14, LV_PART_MAIN);
+        lv_obj_add_style(lbl_name, &g_styles.label, LV_PART_MAIN);
+        lv_obj_add_style(lbl_name, &g_styles.stale_text, LV_PART_MAIN | kStateStale);
+        lv_obj_add_state(lbl_name, kStateStale);
         lv_obj_align(lbl_name, text_only ? LV_ALIGN_LEFT_MID : LV_ALIGN_TOP_LEFT, 0, 0);
 
         lv_obj_t *lbl_value = lv_label_create(row);
         lv_label_set_text(lbl_value, text_only ? "-" : "--");
-        lv_obj_set_style_text_color(lbl_value, kTextSecondary, LV_PART_MAIN);
-        lv_obj_set_style_text_font(lbl_value, &lv_font_montserrat_14, LV_PART_MAIN);
+        lv_obj_add_style(lbl_value, &g_styles.label, LV_PART_MAIN);
+        lv_obj_add_style(lbl_value, &g_styles.stale_text, LV_PART_MAIN | kStateStale);
+        lv_obj_add_state(lbl_value, kStateStale);
+        // Fixed one-line box, right-aligned text: changing the text never resizes the label.
+        lv_label_set_long_mode(lbl_value, text_only ? LV_LABEL_LONG_DOT : LV_LABEL_LONG_CLIP);
+        lv_obj_set_size(lbl_value, LV_PCT(text_only ? 65 : 55), label_h);
+        lv_obj_set_style_text_align(lbl_value, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN);
         lv_obj_align(lbl_value, text_only ? LV_ALIGN_RIGHT_MID : LV_ALIGN_TOP_RIGHT, 0, 0);
-        if (text_only) {
-          lv_label_set_long_mode(lbl_value, LV_LABEL_LONG_DOT);
-          lv_obj_set_width(lbl_value, LV_PCT(65));
-          lv_obj_set_style_text_align(lbl_value, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN);
-        }
 
         lv_obj_t *bar = nullptr;
         if (!text_only) {
@@ -1524,29 +3187,22 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
           lv_bar_set_range(bar, 0, 1000);
           lv_bar_set_value(bar, 0, LV_ANIM_OFF);
           lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, 0);
-          lv_obj_set_style_bg_color(bar, kArcBg, LV_PART_MAIN);
-          lv_obj_set_style_bg_color(bar, kStaleArc, LV_PART_INDICATOR);
-          lv_obj_set_style_radius(bar, 4, LV_PART_MAIN);
-          lv_obj_set_style_radius(bar, 4, LV_PART_INDICATOR);
-          lv_obj_set_style_border_width(bar, 0, LV_PART_MAIN);
+          lv_obj_add_style(bar, &g_styles.bar_main, LV_PART_MAIN);
+          lv_obj_add_style(bar, &g_styles.bar_indicator, LV_PART_INDICATOR);
+          lv_obj_add_style(bar, &g_styles.bar_indicator_stale, LV_PART_INDICATOR | kStateStale);
+          lv_obj_add_state(bar, kStateStale);
         }
 
-        HzRowSlot &slot = hz_rows_[hz_row_count_];
-        slot.used = true;
-        copy_cstr(slot.id, sizeof(slot.id), row_id);
-        copy_cstr(slot.label, sizeof(slot.label), label);
-        slot.text_only = text_only;
-        slot.negative_polarity = negative_polarity;
-        slot.target = target;
         slot.name_label = lbl_name;
         slot.value_label = lbl_value;
         slot.bar = bar;
-        slot.last_update_ms = 0;
-        slot.has_value = false;
-        slot.is_stale = true;
+        if (lbl_name != nullptr && lbl_value != nullptr && (text_only || bar != nullptr)) {
+          hot_.flags[kRowWidgetBase + hz_row_count_] |= WidgetHotState<kWidgetSlots>::kLive;
+        }
 
         ++hz_row_count_;
       }
+      lv_obj_set_height(list_container, row_y > 0 ? row_y - kHzRowGap : 0);
     }
   }
 
@@ -1571,26 +3227,28 @@ bool LiveDashboardImpl::build_from_json_(LiveDashboard &api, JsonObject root) {
 
       lv_obj_t *lbl_title = lv_label_create(tile);
       lv_label_set_text(lbl_title, title);
-      lv_obj_set_style_text_color(lbl_title, kTextPrimary, LV_PART_MAIN);
-      lv_obj_set_style_text_font(lbl_title, &lv_font_montserrat_16, LV_PART_MAIN);
+      lv_obj_add_style(lbl_title, &g_styles.title, LV_PART_MAIN);
       lv_obj_align(lbl_title, LV_ALIGN_TOP_LEFT, 0, 0);
 
       if (subtitle != nullptr) {
         lv_obj_t *lbl_sub = lv_label_create(tile);
         lv_label_set_text(lbl_sub, subtitle);
-        lv_obj_set_style_text_color(lbl_sub, kTextSecondary, LV_PART_MAIN);
-        lv_obj_set_style_text_font(lbl_sub, &lv_font_montserrat_14, LV_PART_MAIN);
+        lv_obj_add_style(lbl_sub, &g_styles.label_dim, LV_PART_MAIN);
         lv_obj_align_to(lbl_sub, lbl_title, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 6);
       }
 
       lv_obj_t *lbl_body = lv_label_create(tile);
       lv_label_set_text(lbl_body, body);
-      lv_obj_set_style_text_color(lbl_body, kTextSecondary, LV_PART_MAIN);
-      lv_obj_set_style_text_font(lbl_body, &lv_font_montserrat_12, LV_PART_MAIN);
+      lv_obj_add_style(lbl_body, &g_styles.caption, LV_PART_MAIN);
       lv_obj_align(lbl_body, LV_ALIGN_BOTTOM_LEFT, 0, 0);
     }
   }
 
+  if (static_background_) {
+    bake_static_background_(scr);
+  }
+
+  compute_config_hash_();
   return true;
 }
 
@@ -1605,12 +3263,28 @@ bool LiveDashboard::begin(fs::FS &fs,
 
 void LiveDashboard::tick() { g_impl.tick(); }
 
+uint32_t LiveDashboard::msUntilNextTick() const { return g_impl.msUntilNextTick(); }
+
 bool LiveDashboard::publishGauge(const char *gauge_id, int32_t value, const char *text) { return g_impl.publishGauge(gauge_id, value, text); }
 
+bool LiveDashboard::bindToCurrentTask() { return g_impl.bindToCurrentTask(); }
+
+LiveDashboardUpdateStats LiveDashboard::updateStats() const { return g_impl.updateStats(); }
+
+size_t LiveDashboard::widgetCount() const { return g_impl.widgetCount(); }
+
+const char *LiveDashboard::widgetId(size_t index) const { return g_impl.widgetId(index); }
+
 bool LiveDashboard::ingestLine(char *line) { return g_impl.ingestLine(line); }
 
 bool LiveDashboard::ingestEventLine(char *line) { return g_impl.ingestEventLine(line); }
 
+void LiveDashboard::beginEventStream() { g_impl.beginEventStream(); }
+
+void LiveDashboard::feedEventStream(const char *data, size_t len) { g_impl.feedEventStream(data, len); }
+
+bool LiveDashboard::endEventStream(char *buffered_line) { return g_impl.endEventStream(buffered_line); }
+
 bool LiveDashboard::onAction(const char *action_id, ActionCallback cb, void *user) { return g_impl.onAction(action_id, cb, user); }
 
 bool LiveDashboard::demoReplayActive() const { return g_impl.demo_replay(); }
@@ -1621,4 +3295,6 @@ uint32_t LiveDashboard::demoCycle() const { return g_impl.demo_cycle(); }
 
 const char *LiveDashboard::robotName() const { return g_impl.robotName(); }
 
+uint32_t LiveDashboard::configHash() const { return g_impl.configHash(); }
+
 } // namespace live_dashboard
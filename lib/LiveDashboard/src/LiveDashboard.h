@@ -5,6 +5,8 @@
 
 #include <FS.h>
 
+#include "LiveDashboardLimits.h"
+
 namespace live_dashboard {
 
 #ifndef LIVE_DASHBOARD_MAX_TILES
@@ -23,10 +25,19 @@ namespace live_dashboard {
 #define LIVE_DASHBOARD_MAX_HZ_ROWS 24
 #endif
 
-#ifndef LIVE_DASHBOARD_ID_MAX_LEN
-#define LIVE_DASHBOARD_ID_MAX_LEN 32
+// Widget updates waiting for the UI task after bindToCurrentTask() (power of two).
+#ifndef LIVE_DASHBOARD_UPDATE_QUEUE_LEN
+#define LIVE_DASHBOARD_UPDATE_QUEUE_LEN 64
 #endif
 
+// Cumulative counters of the cross-task update queue (see LiveDashboard::bindToCurrentTask()).
+struct LiveDashboardUpdateStats {
+  uint32_t queued = 0;    // updates published from other tasks
+  uint32_t dropped = 0;   // ...rejected because the queue was full
+  uint32_t applied = 0;   // ...applied by tick() on the UI task
+  uint32_t max_depth = 0; // most updates waiting at the start of a tick()
+};
+
 struct LiveDashboardOptions {
   bool demo_replay;
   const char *demo_path;
@@ -48,14 +59,42 @@ public:
              char lvgl_drive_letter,
              const LiveDashboardOptions &options = LiveDashboardOptions());
   void tick();
+  // Milliseconds until tick() has work (a gauge or hz row going stale, the next demo line);
+  // UINT32_MAX if nothing is due. Lets the main loop sleep instead of polling.
+  uint32_t msUntilNextTick() const;
 
   bool publishGauge(const char *gauge_id, int32_t value, const char *text);
+
+  // Makes the calling task the UI task (the one running LVGL and tick()). Afterwards
+  // publishGauge() and the ingest functions may be called from any task: on other tasks they
+  // validate and format the update and push it into a lock-free queue (never blocking; a full
+  // queue drops the update) that the next tick() applies. Call it from the UI task before
+  // other tasks start publishing.
+  bool bindToCurrentTask();
+  LiveDashboardUpdateStats updateStats() const;
+
+  // Gauges, then hz_lists rows, in config order (the snapshot order).
+  size_t widgetCount() const;
+  const char *widgetId(size_t index) const;
   bool ingestLine(char *line);
   bool ingestEventLine(char *line);
+
+  // Incremental event ingestion for lines that arrive piecewise (e.g. serial): items are
+  // applied while the line is still streaming in, so neither its length nor its item count
+  // is limited. Pass the whole line to endEventStream() if it was buffered, so input outside
+  // the fast scanner's schema can still fall back to ArduinoJson; otherwise pass nullptr.
+  void beginEventStream();
+  void feedEventStream(const char *data, size_t len);
+  bool endEventStream(char *buffered_line);
+
   bool onAction(const char *action_id, ActionCallback cb, void *user);
 
   const char *robotName() const;
 
+  // Guard for positional snapshots ({"cfg":"<hash hex>","snap":[...]}): FNV-1a over the ids
+  // of all gauges, then all hz_lists rows, in config order.
+  uint32_t configHash() const;
+
   // Demo replay helpers (valid only if demo_replay=true in options)
   bool demoReplayActive() const;
   uint32_t demoFrameIndex() const; // increments per ingested demo line
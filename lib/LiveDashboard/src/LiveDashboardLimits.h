@@ -0,0 +1,12 @@
+#pragma once
+
+// String limits shared by LiveDashboard and its Arduino-free parts (EventScanner), so those
+// build without <FS.h>.
+
+#ifndef LIVE_DASHBOARD_ID_MAX_LEN
+#define LIVE_DASHBOARD_ID_MAX_LEN 32
+#endif
+
+#ifndef LIVE_DASHBOARD_TEXT_MAX_LEN
+#define LIVE_DASHBOARD_TEXT_MAX_LEN 48
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace live_dashboard {
+
+// Bounded multi-producer / single-consumer ring (Vyukov's sequence-numbered cells).
+//
+// Any task may push(); only the task that owns the UI calls pop(). Producers claim a cell with
+// one compare-and-swap on the tail and publish it with a release store of the cell's sequence,
+// so nobody blocks: a full queue makes push() return false instead of waiting, and a producer
+// preempted between claiming and publishing only delays pop() at that cell. N must be a power
+// of two.
+template <typename T, size_t N>
+class MpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscQueue size must be a power of two");
+
+public:
+  MpscQueue() {
+    for (size_t i = 0; i < N; ++i) {
+      cells_[i].seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  bool push(const T &item) {
+    uint32_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & (N - 1)];
+      const uint32_t seq = cell.seq.load(std::memory_order_acquire);
+      const int32_t diff = static_cast<int32_t>(seq - pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.item = item;
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // full: the consumer has not freed this cell yet
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool pop(T *out) {
+    Cell &cell = cells_[head_ & (N - 1)];
+    const uint32_t seq = cell.seq.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(seq - (head_ + 1)) < 0) {
+      return false; // empty, or the producer of this cell has not finished writing it
+    }
+    *out = cell.item;
+    cell.seq.store(head_ + N, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+  // Consumer side: items pushed but not yet popped (approximate while producers are active).
+  size_t depth() const { return static_cast<size_t>(tail_.load(std::memory_order_relaxed) - head_); }
+
+  static constexpr size_t capacity() { return N; }
+
+private:
+  struct Cell {
+    std::atomic<uint32_t> seq;
+    T item;
+  };
+
+  Cell cells_[N];
+  std::atomic<uint32_t> tail_{0};
+  uint32_t head_ = 0; // consumer only
+};
+
+} // namespace live_dashboard
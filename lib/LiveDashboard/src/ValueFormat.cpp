@@ -0,0 +1,110 @@
+#include "ValueFormat.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace live_dashboard {
+
+static int64_t gcd_(int64_t a, int64_t b) {
+  if (a < 0) a = -a;
+  if (b < 0) b = -b;
+  while (b != 0) {
+    const int64_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+bool compileValueFormat(double scale, uint8_t decimals, const char *unit, const char *suffix, ValueFormat *out) {
+  if (out == nullptr || decimals > kValueFormatMaxDecimals || !std::isfinite(scale) || scale == 0.0) {
+    return false;
+  }
+
+  // value * scale * 10^decimals must become value * mul / div with div = 10^k.
+  const double factor = scale * std::pow(10.0, decimals);
+  int64_t mul = 0;
+  int64_t div = 1;
+  bool found = false;
+  for (int k = 0; k <= 6 && !found; ++k, div *= 10) {
+    const double n = factor * static_cast<double>(div);
+    const double r = std::round(n);
+    if (std::fabs(n - r) <= 1e-9 * (std::fabs(n) > 1.0 ? std::fabs(n) : 1.0)) {
+      mul = static_cast<int64_t>(r);
+      found = true;
+      break;
+    }
+  }
+  if (!found || mul == 0) {
+    return false;
+  }
+  const int64_t g = gcd_(mul, div);
+  mul /= g;
+  div /= g;
+  if (mul > INT32_MAX || mul < -INT32_MAX || div > INT32_MAX) {
+    return false;
+  }
+
+  const size_t unit_len = (unit != nullptr) ? strlen(unit) : 0;
+  const size_t suffix_len = (suffix != nullptr) ? strlen(suffix) : 0;
+  if (unit_len + suffix_len >= sizeof(out->tail)) {
+    return false;
+  }
+
+  ValueFormat f;
+  f.mul = static_cast<int32_t>(mul);
+  f.div = static_cast<int32_t>(div);
+  f.decimals = decimals;
+  if (unit_len > 0) memcpy(f.tail, unit, unit_len);
+  if (suffix_len > 0) memcpy(f.tail + unit_len, suffix, suffix_len);
+  f.tail_len = static_cast<uint8_t>(unit_len + suffix_len);
+  f.tail[f.tail_len] = '\0';
+  *out = f;
+  return true;
+}
+
+size_t renderValueFormat(const ValueFormat &format, int32_t value, char *out, size_t out_size) {
+  if (out == nullptr || out_size == 0) {
+    return 0;
+  }
+
+  int64_t scaled = static_cast<int64_t>(value) * format.mul;
+  if (format.div > 1) {
+    const int64_t half = format.div / 2;
+    scaled = (scaled >= 0 ? scaled + half : scaled - half) / format.div; // round half away from zero
+  }
+
+  const bool negative = scaled < 0;
+  uint64_t magnitude = negative ? static_cast<uint64_t>(-scaled) : static_cast<uint64_t>(scaled);
+
+  // Digits are produced right to left, with the decimal point after `decimals` digits.
+  char digits[24];
+  size_t n = 0;
+  for (uint8_t i = 0; i < format.decimals; ++i) {
+    digits[n++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  }
+  if (format.decimals > 0) {
+    digits[n++] = '.';
+  }
+  do {
+    digits[n++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+
+  size_t len = 0;
+  const size_t cap = out_size - 1;
+  if (negative && len < cap) {
+    out[len++] = '-';
+  }
+  while (n > 0 && len < cap) {
+    out[len++] = digits[--n];
+  }
+  for (size_t i = 0; i < format.tail_len && len < cap; ++i) {
+    out[len++] = format.tail[i];
+  }
+  out[len] = '\0';
+  return len;
+}
+
+} // namespace live_dashboard
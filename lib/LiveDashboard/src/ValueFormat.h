@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace live_dashboard {
+
+// Display format for a widget's integer value, compiled once from its config
+// ("format": {"scale": 0.1, "decimals": 1, "unit": "V", "suffix": ""}) into integer math:
+//
+//   shown = round(value * mul / div) / 10^decimals, followed by unit + suffix
+//
+// so rendering needs neither floats nor printf. The default format prints the plain value.
+struct ValueFormat {
+  int32_t mul = 1;
+  int32_t div = 1;
+  uint8_t decimals = 0;
+  uint8_t tail_len = 0;
+  char tail[24]{}; // unit + suffix
+};
+
+static constexpr uint8_t kValueFormatMaxDecimals = 6;
+
+// Longest possible output of renderValueFormat() including the terminator.
+static constexpr size_t kValueFormatMaxText = 1 + 20 + 1 + sizeof(ValueFormat::tail);
+
+// Returns false if the spec cannot be represented (scale not a ratio with a power-of-ten
+// denominator up to 10^6 that fits int32, too many decimals, unit + suffix too long).
+bool compileValueFormat(double scale, uint8_t decimals, const char *unit, const char *suffix, ValueFormat *out);
+
+// Writes the formatted value (NUL-terminated, truncated to out_size) and returns its length.
+size_t renderValueFormat(const ValueFormat &format, int32_t value, char *out, size_t out_size);
+
+} // namespace live_dashboard
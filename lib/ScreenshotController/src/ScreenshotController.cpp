@@ -1,4 +1,5 @@
 #include "ScreenshotController.h"
+#include "SerialFrameWriter.h"
 
 #include <Arduino.h>
 
@@ -8,28 +9,69 @@
 #ifndef ROVI_ENABLE_SCREENSHOTS
 #define ROVI_ENABLE_SCREENSHOTS 0
 #endif
+// 0 = BMP, 1 = RLE565 (decode with tools/screenshot_decode.py)
+#ifndef ROVI_SCREENSHOT_FORMAT
+#define ROVI_SCREENSHOT_FORMAT 0
+#endif
+// 1 = record one delta stream per replay cycle instead of a file per frame
+// (reconstruct with tools/delta_replay.py)
+#ifndef ROVI_SCREENSHOT_RECORD
+#define ROVI_SCREENSHOT_RECORD 0
+#endif
+// Capture triggers outside of demo replay (0 disables the trigger).
+#ifndef ROVI_SCREENSHOT_LONG_PRESS_MS
+#define ROVI_SCREENSHOT_LONG_PRESS_MS 3000U
+#endif
+#ifndef ROVI_SCREENSHOT_INTERVAL_MS
+#define ROVI_SCREENSHOT_INTERVAL_MS 0U
+#endif
+
+static constexpr const char *kRunCachePath = "/screenshots/last_run";
 
 namespace screenshot {
 
 ScreenshotController::ScreenshotController(ws_lcd_35_s3_hal::WsLcd35S3Hal &hal,
                                            live_dashboard::LiveDashboard &dash)
-    : hal_(hal), dash_(dash) {}
+    : hal_(hal),
+      dash_(dash),
+      format_(ROVI_SCREENSHOT_FORMAT == 1 ? ws_lcd_35_s3_hal::ScreenshotFormat::kRle565
+                                          : ws_lcd_35_s3_hal::ScreenshotFormat::kBmp),
+      mode_(ROVI_SCREENSHOT_RECORD != 0 ? CaptureMode::kDelta : CaptureMode::kFrames),
+      long_press_ms_(ROVI_SCREENSHOT_LONG_PRESS_MS),
+      interval_ms_(ROVI_SCREENSHOT_INTERVAL_MS) {}
 
-bool ScreenshotController::choose_next_capture_dir_() {
+uint32_t ScreenshotController::read_cached_run_() {
 #if ROVI_ENABLE_SCREENSHOTS
-  if (!hal_.sdFs().exists("/screenshots")) {
-    hal_.sdFs().mkdir("/screenshots");
+  File f = hal_.sdFs().open(kRunCachePath, FILE_READ);
+  if (!f) {
+    return 0;
   }
+  char buf[16]{};
+  const size_t n = f.read(reinterpret_cast<uint8_t *>(buf), sizeof(buf) - 1);
+  f.close();
+  buf[n] = '\0';
+  char *end = nullptr;
+  const unsigned long val = strtoul(buf, &end, 10);
+  return (end != buf) ? static_cast<uint32_t>(val) : 0;
+#else
+  return 0;
+#endif
+}
 
+uint32_t ScreenshotController::scan_max_run_() {
+#if ROVI_ENABLE_SCREENSHOTS
   uint32_t max_run = 0;
   File dir = hal_.sdFs().open("/screenshots");
   if (dir && dir.isDirectory()) {
     File f = dir.openNextFile();
     while (f) {
       if (f.isDirectory()) {
+        // Depending on the core version name() is either the full path or the basename.
         const char *name = f.name();
-        if (name != nullptr && strncmp(name, "/screenshots/run_", 17) == 0) {
-          const char *num = name + 17;
+        const char *base = (name != nullptr) ? strrchr(name, '/') : nullptr;
+        base = (base != nullptr) ? base + 1 : name;
+        if (base != nullptr && strncmp(base, "run_", 4) == 0) {
+          const char *num = base + 4;
           char *end = nullptr;
           unsigned long val = strtoul(num, &end, 10);
           if (end != num && val > max_run) {
@@ -40,14 +82,38 @@ bool ScreenshotController::choose_next_capture_dir_() {
       f = dir.openNextFile();
     }
   }
+  return max_run;
+#else
+  return 0;
+#endif
+}
 
-  const uint32_t next_run = max_run + 1;
+bool ScreenshotController::choose_next_capture_dir_() {
+#if ROVI_ENABLE_SCREENSHOTS
+  if (!hal_.sdFs().exists("/screenshots")) {
+    hal_.sdFs().mkdir("/screenshots");
+  }
+
+  // The last run number is cached on the card so boot does not have to walk /screenshots;
+  // fall back to a scan if the cache is missing or stale.
+  uint32_t next_run = read_cached_run_() + 1;
   snprintf(dir_, sizeof(dir_), "/screenshots/run_%u", static_cast<unsigned>(next_run));
+  if (next_run == 1 || hal_.sdFs().exists(dir_)) {
+    next_run = scan_max_run_() + 1;
+    snprintf(dir_, sizeof(dir_), "/screenshots/run_%u", static_cast<unsigned>(next_run));
+  }
+
   if (!hal_.sdFs().mkdir(dir_)) {
     Serial.printf("WARN: mkdir %s failed (screenshots disabled)\n", dir_);
     dir_[0] = '\0';
     return false;
   }
+
+  File cache = hal_.sdFs().open(kRunCachePath, FILE_WRITE);
+  if (cache) {
+    cache.printf("%u\n", static_cast<unsigned>(next_run));
+    cache.close();
+  }
   return true;
 #else
   return false;
@@ -84,44 +150,132 @@ void ScreenshotController::begin() {
   counter_ = 0;
   last_frame_ = 0;
   target_cycle_ = 0;
+  capture_requested_ = false;
+  last_interval_ms_ = millis();
+  hal_.setLongPressMs(long_press_ms_);
 
-  if (!dash_.demoReplayActive()) {
-    Serial.println("Screenshots disabled: demo replay off");
+  if (!hal_.sdFsMounted()) {
+    Serial.println("Screenshots: SD missing (serial !snap only)");
     return;
   }
-  if (!hal_.sdFsMounted()) {
-    Serial.println("Screenshots disabled: SD missing");
+
+  Serial.printf("Screenshots ready: !shot, long-press=%ums, interval=%ums\n",
+                static_cast<unsigned>(long_press_ms_),
+                static_cast<unsigned>(interval_ms_));
+
+  // Demo replay additionally records one full cycle into its own run directory.
+  if (!dash_.demoReplayActive()) {
     return;
   }
   if (!choose_next_capture_dir_()) {
     return;
   }
 
+  if (mode_ == CaptureMode::kDelta && !open_delta_stream_()) {
+    return;
+  }
+
   active_ = true;
   target_cycle_ = dash_.demoCycle();
   counter_ = 0;
   last_frame_ = 0;
   listed_ = false;
-  Serial.printf("Screenshots enabled: %s\n", dir_);
+  Serial.printf("Screenshots enabled: %s (%s)\n",
+                dir_,
+                mode_ == CaptureMode::kDelta ? "delta" : ws_lcd_35_s3_hal::screenshotFileExtension(format_));
+#endif
+}
+
+bool ScreenshotController::handleCommand(const char *line) {
+  if (line == nullptr) {
+    return false;
+  }
+  const bool snap = strcmp(line, "!snap") == 0;
+  const bool shot = strcmp(line, "!shot") == 0;
+  if (!snap && !shot) {
+    return false;
+  }
+#if ROVI_ENABLE_SCREENSHOTS
+  if (shot) {
+    request_sd_capture_("serial");
+    return true;
+  }
+  if (!hal_.requestCapture()) {
+    Serial.println("SNAP: capture unavailable (mirror buffer missing)");
+    return true;
+  }
+  serial_requested_ = true;
+#else
+  Serial.println("SNAP: screenshots disabled at compile time (ROVI_ENABLE_SCREENSHOTS=0)");
+#endif
+  return true;
+}
+
+bool ScreenshotController::request_sd_capture_(const char *reason) {
+#if ROVI_ENABLE_SCREENSHOTS
+  if (!hal_.sdFsMounted()) {
+    Serial.printf("Screenshot (%s) skipped: SD missing\n", reason);
+    return false;
+  }
+  if (dir_[0] == '\0' && !choose_next_capture_dir_()) {
+    return false;
+  }
+  if (!hal_.requestCapture()) {
+    Serial.printf("Screenshot (%s) skipped: mirror buffer missing\n", reason);
+    return false;
+  }
+  capture_requested_ = true;
+  announce_capture_ = !active_;
+  return true;
+#else
+  (void)reason;
+  return false;
 #endif
 }
 
 void ScreenshotController::tick() {
 #if ROVI_ENABLE_SCREENSHOTS
+  // A requested capture is written once the HAL has mirrored a complete refresh. Waiting for
+  // it only holds back that write: triggers and replay bookkeeping below keep running, and a
+  // trigger firing meanwhile joins the pending capture.
+  if ((serial_requested_ || capture_requested_) && hal_.captureReady()) {
+    if (serial_requested_) {
+      serial_requested_ = false;
+      stream_capture_();
+    }
+    if (capture_requested_) {
+      capture_requested_ = false;
+      write_capture_();
+    } else {
+      hal_.releaseCapture();
+    }
+  }
+
+  if (long_press_ms_ > 0 && hal_.takeLongPress()) {
+    request_sd_capture_("long-press");
+  }
+  if (interval_ms_ > 0 && hal_.sdFsMounted()) {
+    const uint32_t now_ms = millis();
+    if (now_ms - last_interval_ms_ >= interval_ms_) {
+      last_interval_ms_ = now_ms;
+      request_sd_capture_("interval");
+    }
+  }
+
   if (!active_) {
     return;
   }
+
   if (!dash_.demoReplayActive()) {
     return;
   }
 
   const uint32_t cycle = dash_.demoCycle();
   if (cycle > target_cycle_) {
-    active_ = false;
-    if (!listed_) {
-      list_capture_dir_();
-      listed_ = true;
+    if (mode_ == CaptureMode::kDelta) {
+      write_delta_frame_(last_frame_);
     }
+    finish_run_();
     return;
   }
   if (cycle < target_cycle_) {
@@ -129,22 +283,152 @@ void ScreenshotController::tick() {
   }
 
   const uint32_t frame = dash_.demoFrameIndex();
-  if (frame == 0 || frame == last_frame_) {
+  if (mode_ == CaptureMode::kDelta) {
+    // Rectangles flushed since the previous frame change belong to the previous frame: the
+    // new demo line was ingested this loop pass and has not been rendered yet.
+    if (frame != last_frame_) {
+      write_delta_frame_(last_frame_);
+      last_frame_ = frame;
+    }
+    return;
+  }
+
+  // One file per frame: a frame change waits until the previous frame's file is written.
+  if (frame == 0 || frame == last_frame_ || capture_requested_) {
     return;
   }
   last_frame_ = frame;
 
+  if (!request_sd_capture_("replay")) {
+    finish_run_();
+  }
+#endif
+}
+
+void ScreenshotController::stream_capture_() {
+#if ROVI_ENABLE_SCREENSHOTS
+  // Always RLE565 over the wire: a flat dashboard frame is a few tens of KiB instead of 300 KiB.
+  const auto format = ws_lcd_35_s3_hal::ScreenshotFormat::kRle565;
+  SerialFrameWriter frame(Serial);
+  if (serial_guard_ != nullptr) {
+    serial_guard_(true, serial_guard_ctx_);
+  }
+  const uint32_t start_ms = millis();
+  bool ok = frame.begin(static_cast<uint8_t>(format), hal_.width(), hal_.height(), ++serial_seq_);
+  ok = ok && hal_.writeScreenshot(frame, format);
+  ok = frame.end() && ok;
+  if (!ok) {
+    Serial.println("SNAP: stream failed");
+  } else {
+    Serial.printf("\nSNAP: seq=%u bytes=%u ms=%u\n",
+                  static_cast<unsigned>(serial_seq_),
+                  static_cast<unsigned>(frame.totalBytes()),
+                  static_cast<unsigned>(millis() - start_ms));
+  }
+  if (serial_guard_ != nullptr) {
+    serial_guard_(false, serial_guard_ctx_);
+  }
+#endif
+}
+
+void ScreenshotController::finish_run_() {
+#if ROVI_ENABLE_SCREENSHOTS
+  active_ = false;
+  if (delta_file_) {
+    delta_file_.close();
+  }
+  hal_.setRecording(false);
+  if (!listed_) {
+    list_capture_dir_();
+    listed_ = true;
+  }
+#endif
+}
+
+bool ScreenshotController::open_delta_stream_() {
+#if ROVI_ENABLE_SCREENSHOTS
+  char path[96];
+  snprintf(path, sizeof(path), "%s/replay.rvd", dir_);
+  delta_file_ = hal_.sdFs().open(path, FILE_WRITE);
+  if (!delta_file_) {
+    Serial.printf("Screenshots disabled: cannot open %s\n", path);
+    return false;
+  }
+
+  // "RVDS" | u8 version | u8 reserved | u16 width | u16 height | u16 reserved
+  const uint16_t w = hal_.width();
+  const uint16_t h = hal_.height();
+  const uint8_t header[12] = {'R', 'V', 'D', 'S', 1, 0,
+                              static_cast<uint8_t>(w & 0xFF), static_cast<uint8_t>(w >> 8),
+                              static_cast<uint8_t>(h & 0xFF), static_cast<uint8_t>(h >> 8),
+                              0, 0};
+  if (delta_file_.write(header, sizeof(header)) != sizeof(header) || !hal_.setRecording(true)) {
+    Serial.println("Screenshots disabled: delta stream init failed");
+    delta_file_.close();
+    return false;
+  }
+  delta_start_ms_ = millis();
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ScreenshotController::write_delta_frame_(uint32_t frame_index) {
+#if ROVI_ENABLE_SCREENSHOTS
+  if (!delta_file_) {
+    return;
+  }
+
+  lv_area_t rects[ws_lcd_35_s3_hal::WsLcd35S3Hal::kMaxDirtyRects];
+  const size_t count = hal_.takeDirtyRects(rects, ws_lcd_35_s3_hal::WsLcd35S3Hal::kMaxDirtyRects);
+
+  // u32 frame | u32 t_ms | u16 rect_count, then per rect: u16 x, y, w, h + RLE565 rows
+  const uint32_t t_ms = millis() - delta_start_ms_;
+  uint8_t rec[10];
+  for (int i = 0; i < 4; ++i) {
+    rec[i] = static_cast<uint8_t>((frame_index >> (8 * i)) & 0xFF);
+    rec[4 + i] = static_cast<uint8_t>((t_ms >> (8 * i)) & 0xFF);
+  }
+  rec[8] = static_cast<uint8_t>(count & 0xFF);
+  rec[9] = static_cast<uint8_t>((count >> 8) & 0xFF);
+  bool ok = delta_file_.write(rec, sizeof(rec)) == sizeof(rec);
+
+  for (size_t i = 0; ok && i < count; ++i) {
+    const lv_area_t &a = rects[i];
+    const uint16_t fields[4] = {static_cast<uint16_t>(a.x1), static_cast<uint16_t>(a.y1),
+                                static_cast<uint16_t>(lv_area_get_width(&a)), static_cast<uint16_t>(lv_area_get_height(&a))};
+    uint8_t hdr[8];
+    for (int f = 0; f < 4; ++f) {
+      hdr[2 * f] = static_cast<uint8_t>(fields[f] & 0xFF);
+      hdr[2 * f + 1] = static_cast<uint8_t>(fields[f] >> 8);
+    }
+    ok = delta_file_.write(hdr, sizeof(hdr)) == sizeof(hdr) && hal_.writeRle565Rect(delta_file_, a);
+  }
+
+  if (!ok) {
+    Serial.println("Screenshot delta write failed");
+    finish_run_();
+    return;
+  }
+  ++counter_;
+#endif
+}
+
+void ScreenshotController::write_capture_() {
+#if ROVI_ENABLE_SCREENSHOTS
   ++counter_;
   char path[96];
-  snprintf(path, sizeof(path), "%s/%u.bmp", dir_, static_cast<unsigned>(counter_));
-  const bool ok = hal_.captureScreenshotBmp(path);
+  snprintf(path, sizeof(path), "%s/%u.%s", dir_, static_cast<unsigned>(counter_),
+           ws_lcd_35_s3_hal::screenshotFileExtension(format_));
+  const bool ok = hal_.captureScreenshot(path, format_);
   if (!ok) {
     Serial.printf("Screenshot failed: %s\n", path);
-    active_ = false;
-    if (!listed_) {
-      list_capture_dir_();
-      listed_ = true;
+    if (active_) {
+      finish_run_();
     }
+  } else if (announce_capture_) {
+    Serial.printf("Screenshot saved: %s\n", path);
   }
 #endif
 }
@@ -7,6 +7,11 @@
 
 namespace screenshot {
 
+enum class CaptureMode : uint8_t {
+  kFrames, // one full screenshot file per demo frame
+  kDelta,  // one delta stream (replay.rvd) with only the rectangles flushed between frames
+};
+
 class ScreenshotController {
 public:
   ScreenshotController(ws_lcd_35_s3_hal::WsLcd35S3Hal &hal, live_dashboard::LiveDashboard &dash);
@@ -14,19 +19,63 @@ public:
   void begin();
   void tick();
 
+  // Handles screenshot commands received as a text line. Returns true if the line was consumed.
+  //   !snap  -> capture after the next refresh and stream it over Serial as an RVSF frame
+  //   !shot  -> capture after the next refresh into the current SD run directory
+  bool handleCommand(const char *line);
+
+  // SD capture triggers that work without demo replay (0 disables them). Set before begin().
+  void setLongPressMs(uint32_t hold_ms) { long_press_ms_ = hold_ms; }
+  void setIntervalMs(uint32_t interval_ms) { interval_ms_ = interval_ms; }
+
+  // Called with true before a !snap frame goes out on Serial and with false after its result
+  // line. When other tasks also write to Serial, hold them off in between: a log line inside the
+  // frame corrupts it.
+  using SerialGuard = void (*)(bool hold, void *ctx);
+  void setSerialGuard(SerialGuard guard, void *ctx) {
+    serial_guard_ = guard;
+    serial_guard_ctx_ = ctx;
+  }
+
+  void setFormat(ws_lcd_35_s3_hal::ScreenshotFormat format) { format_ = format; }
+  ws_lcd_35_s3_hal::ScreenshotFormat format() const { return format_; }
+  void setMode(CaptureMode mode) { mode_ = mode; }
+  CaptureMode mode() const { return mode_; }
+
 private:
+  uint32_t read_cached_run_();
+  uint32_t scan_max_run_();
   bool choose_next_capture_dir_();
+  bool request_sd_capture_(const char *reason);
   void list_capture_dir_();
+  void write_capture_();
+  void stream_capture_();
+  bool open_delta_stream_();
+  void write_delta_frame_(uint32_t frame_index);
+  void finish_run_();
 
   ws_lcd_35_s3_hal::WsLcd35S3Hal &hal_;
   live_dashboard::LiveDashboard &dash_;
 
   bool active_ = false;
   bool listed_ = false;
+  bool capture_requested_ = false;
+  bool announce_capture_ = false;
+  bool serial_requested_ = false;
+  uint32_t serial_seq_ = 0;
   uint32_t target_cycle_ = 0;
   uint32_t last_frame_ = 0;
   uint32_t counter_ = 0;
+  ws_lcd_35_s3_hal::ScreenshotFormat format_ = ws_lcd_35_s3_hal::ScreenshotFormat::kBmp;
+  CaptureMode mode_ = CaptureMode::kFrames;
+  File delta_file_{};
+  uint32_t delta_start_ms_ = 0;
+  uint32_t long_press_ms_ = 0;
+  uint32_t interval_ms_ = 0;
+  uint32_t last_interval_ms_ = 0;
   char dir_[64]{};
+  SerialGuard serial_guard_ = nullptr;
+  void *serial_guard_ctx_ = nullptr;
 };
 
 } // namespace screenshot
@@ -0,0 +1,111 @@
+#include "SerialFrameWriter.h"
+
+#include <cstring>
+
+namespace screenshot {
+namespace {
+
+inline void put_u16_(uint8_t *out, uint16_t v) {
+  out[0] = static_cast<uint8_t>(v & 0xFF);
+  out[1] = static_cast<uint8_t>((v >> 8) & 0xFF);
+}
+
+inline void put_u32_(uint8_t *out, uint32_t v) {
+  put_u16_(out, static_cast<uint16_t>(v & 0xFFFF));
+  put_u16_(out + 2, static_cast<uint16_t>((v >> 16) & 0xFFFF));
+}
+
+} // namespace
+
+uint16_t SerialFrameWriter::crc16(const uint8_t *data, size_t len, uint16_t crc) {
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= static_cast<uint16_t>(data[i]) << 8;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+bool SerialFrameWriter::begin(uint8_t format, uint16_t width, uint16_t height, uint32_t seq) {
+  chunk_len_ = 0;
+  total_ = 0;
+  ok_ = true;
+
+  uint8_t header[16];
+  header[0] = 'R';
+  header[1] = 'V';
+  header[2] = 'S';
+  header[3] = 'F';
+  header[4] = kVersion;
+  header[5] = format;
+  put_u16_(header + 6, width);
+  put_u16_(header + 8, height);
+  put_u32_(header + 10, seq);
+  put_u16_(header + 14, crc16(header, 14));
+  return writeAll_(header, sizeof(header));
+}
+
+size_t SerialFrameWriter::write(const uint8_t *buffer, size_t size) {
+  if (!ok_ || buffer == nullptr) {
+    return 0;
+  }
+
+  size_t done = 0;
+  while (done < size) {
+    const size_t room = kChunkBytes - chunk_len_;
+    const size_t n = (size - done < room) ? (size - done) : room;
+    memcpy(chunk_ + chunk_len_, buffer + done, n);
+    chunk_len_ += n;
+    done += n;
+    if (chunk_len_ == kChunkBytes && !flushChunk_()) {
+      return 0;
+    }
+  }
+  total_ += static_cast<uint32_t>(size);
+  return size;
+}
+
+bool SerialFrameWriter::end() {
+  if (!flushChunk_()) {
+    return false;
+  }
+  uint8_t trailer[6];
+  put_u16_(trailer, 0);
+  put_u32_(trailer + 2, total_);
+  const bool ok = writeAll_(trailer, sizeof(trailer));
+  out_.flush();
+  return ok;
+}
+
+bool SerialFrameWriter::flushChunk_() {
+  if (!ok_) {
+    return false;
+  }
+  if (chunk_len_ == 0) {
+    return true;
+  }
+
+  uint8_t len[2];
+  uint8_t crc[2];
+  put_u16_(len, static_cast<uint16_t>(chunk_len_));
+  put_u16_(crc, crc16(chunk_, chunk_len_));
+  const bool ok = writeAll_(len, sizeof(len)) && writeAll_(chunk_, chunk_len_) && writeAll_(crc, sizeof(crc));
+  chunk_len_ = 0;
+  return ok;
+}
+
+bool SerialFrameWriter::writeAll_(const uint8_t *data, size_t len) {
+  size_t done = 0;
+  while (ok_ && done < len) {
+    const size_t n = out_.write(data + done, len - done);
+    if (n == 0) {
+      ok_ = false;
+      break;
+    }
+    done += n;
+  }
+  return ok_;
+}
+
+} // namespace screenshot
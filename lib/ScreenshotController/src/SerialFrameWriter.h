@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Print.h>
+
+namespace screenshot {
+
+// Wraps a byte stream (e.g. an encoded screenshot) into a chunked, checksummed binary frame
+// so a host can pick it out of the regular serial log output.
+//
+// Frame layout (little-endian):
+//   header  "RVSF" | u8 version (1) | u8 format | u16 width | u16 height | u32 seq | u16 crc16(header[0..13])
+//   chunk   u16 len (1..kChunkBytes) | len bytes | u16 crc16(payload)
+//   end     u16 0 | u32 total payload bytes
+//
+// crc16 is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF). Decoder: tools/serial_screenshot.py
+class SerialFrameWriter : public Print {
+public:
+  static constexpr size_t kChunkBytes = 1024;
+  static constexpr uint8_t kVersion = 1;
+
+  explicit SerialFrameWriter(Print &out) : out_(out) {}
+
+  bool begin(uint8_t format, uint16_t width, uint16_t height, uint32_t seq);
+  bool end();
+
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override;
+
+  uint32_t totalBytes() const { return total_; }
+
+  static uint16_t crc16(const uint8_t *data, size_t len, uint16_t crc = 0xFFFF);
+
+private:
+  bool flushChunk_();
+  bool writeAll_(const uint8_t *data, size_t len);
+
+  Print &out_;
+  uint8_t chunk_[kChunkBytes]{};
+  size_t chunk_len_ = 0;
+  uint32_t total_ = 0;
+  bool ok_ = true;
+};
+
+} // namespace screenshot
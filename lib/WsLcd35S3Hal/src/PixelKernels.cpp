@@ -0,0 +1,315 @@
+#include "PixelKernels.h"
+
+#include <cstring>
+
+#ifndef ROVI_PIE_KERNELS
+#define ROVI_PIE_KERNELS 0
+#endif
+
+#if ROVI_PIE_KERNELS
+#include "sdkconfig.h"
+#if !defined(CONFIG_IDF_TARGET_ESP32S3)
+#error "ROVI_PIE_KERNELS needs an ESP32-S3 target"
+#endif
+#endif
+
+namespace ws_lcd_35_s3_hal {
+namespace {
+
+static bool g_accelerated = true;
+
+inline uint16_t blend_pixel_(uint32_t fg, uint16_t bg_px, uint32_t mix) {
+  // fg and bg spread to 0b00000gggggg00000rrrrr000000bbbbb so one multiply scales all channels.
+  const uint32_t bg = (static_cast<uint32_t>(bg_px) | (static_cast<uint32_t>(bg_px) << 16)) & 0x07E0F81FU;
+  const uint32_t result = ((((fg - bg) * mix) >> 5) + bg) & 0x07E0F81FU;
+  return static_cast<uint16_t>((result >> 16) | result);
+}
+
+inline uint32_t spread565_(uint16_t c) {
+  return (static_cast<uint32_t>(c) | (static_cast<uint32_t>(c) << 16)) & 0x07E0F81FU;
+}
+
+inline uint32_t mix5_(uint8_t opa) {
+  return (static_cast<uint32_t>(opa) + 4U) >> 3;
+}
+
+// fill_normal() rounds opa the way lv_color_mix() does, into an lv_opa_t: 252 becomes 256 -> 0.
+inline uint8_t premult_opa_(uint8_t opa) {
+  return static_cast<uint8_t>(mix5_(opa) << 3);
+}
+
+// LV_UDIV255()
+inline uint32_t udiv255_(uint32_t x) {
+  return (x * 0x8081U) >> 23;
+}
+
+#if ROVI_PIE_KERNELS
+// 16-byte aligned blocks of 8 pixels through one 128-bit vector register. Not yet built or run
+// on hardware; the boot self-test falls back to the references if they disagree.
+void fill565_blocks_(uint16_t *&dst, uint16_t color, size_t blocks) {
+  const uint16_t c = color;
+  asm volatile(
+      "ee.vldbc.16 q0, %[c]\n"
+      "1:\n"
+      "ee.vst.128.ip q0, %[dst], 16\n"
+      "addi %[n], %[n], -1\n"
+      "bnez %[n], 1b\n"
+      : [dst] "+r"(dst), [n] "+r"(blocks)
+      : [c] "r"(&c)
+      : "memory");
+}
+
+void copy565_blocks_(uint16_t *&dst, const uint16_t *&src, size_t blocks) {
+  asm volatile(
+      "1:\n"
+      "ee.vld.128.ip q0, %[src], 16\n"
+      "ee.vst.128.ip q0, %[dst], 16\n"
+      "addi %[n], %[n], -1\n"
+      "bnez %[n], 1b\n"
+      : [dst] "+r"(dst), [src] "+r"(src), [n] "+r"(blocks)
+      :
+      : "memory");
+}
+#endif
+
+// 32-bit stores of two pixels (PIE 128-bit stores first with ROVI_PIE_KERNELS).
+void fill565Words_(uint16_t *dst, uint16_t color, size_t n) {
+  while (n > 0 && (reinterpret_cast<uintptr_t>(dst) & 3U) != 0) {
+    *dst++ = color;
+    --n;
+  }
+#if ROVI_PIE_KERNELS
+  while (n > 0 && (reinterpret_cast<uintptr_t>(dst) & 15U) != 0) {
+    *dst++ = color;
+    --n;
+  }
+  if (n >= 8) {
+    const size_t blocks = n / 8;
+    fill565_blocks_(dst, color, blocks);
+    n -= blocks * 8;
+  }
+#endif
+  const uint32_t pair = static_cast<uint32_t>(color) | (static_cast<uint32_t>(color) << 16);
+  uint32_t *dst2 = reinterpret_cast<uint32_t *>(dst);
+  for (; n >= 2; n -= 2) {
+    *dst2++ = pair;
+  }
+  dst = reinterpret_cast<uint16_t *>(dst2);
+  if (n > 0) {
+    *dst = color;
+  }
+}
+
+// Same per-pixel algorithm as blend565Ref() with the premultiplied color computed once.
+void blend565Scalar_(uint16_t *dst, size_t stride, size_t w, size_t h, uint16_t color, uint8_t opa) {
+  if (w == 0 || h == 0) {
+    return;
+  }
+  // Areas blended over are mostly flat, so reuse the result while the background repeats (as
+  // LVGL does, which is also why the cache has to start from black and span rows).
+  const uint32_t p_opa = premult_opa_(opa);
+  const uint32_t inv = 255U - p_opa;
+  const uint32_t r_pre = (color >> 11) * p_opa;
+  const uint32_t g_pre = ((color >> 5) & 0x3FU) * p_opa;
+  const uint32_t b_pre = (color & 0x1FU) * p_opa;
+  uint16_t last_bg = 0;
+  uint16_t last_res = blend_pixel_(spread565_(color), 0, mix5_(opa));
+  for (size_t y = 0; y < h; ++y, dst += stride) {
+    for (size_t x = 0; x < w; ++x) {
+      const uint16_t bg = dst[x];
+      if (bg != last_bg) {
+        last_bg = bg;
+        const uint32_t r = udiv255_(r_pre + (bg >> 11) * inv);
+        const uint32_t g = udiv255_(g_pre + ((bg >> 5) & 0x3FU) * inv);
+        const uint32_t b = udiv255_(b_pre + (bg & 0x1FU) * inv);
+        last_res = static_cast<uint16_t>((r << 11) | (g << 5) | b);
+      }
+      dst[x] = last_res;
+    }
+  }
+}
+
+// Two pixels per 32-bit load/store when both pointers are word aligned.
+void swap565Words_(uint16_t *dst, const uint16_t *src, size_t n) {
+  size_t i = 0;
+  if ((reinterpret_cast<uintptr_t>(src) & 3U) == 0 && (reinterpret_cast<uintptr_t>(dst) & 3U) == 0) {
+    const uint32_t *s2 = reinterpret_cast<const uint32_t *>(src);
+    uint32_t *d2 = reinterpret_cast<uint32_t *>(dst);
+    for (; i + 2 <= n; i += 2) {
+      const uint32_t v = *s2++;
+      *d2++ = ((v & 0x00FF00FFU) << 8) | ((v >> 8) & 0x00FF00FFU);
+    }
+  }
+  for (; i < n; ++i) {
+    dst[i] = static_cast<uint16_t>((src[i] >> 8) | (src[i] << 8));
+  }
+}
+
+// memcpy (PIE 128-bit loads/stores first with ROVI_PIE_KERNELS).
+void copy565Memcpy_(uint16_t *dst, const uint16_t *src, size_t n) {
+#if ROVI_PIE_KERNELS
+  // The vector loads need both pointers on the same 16-byte phase; others go to memcpy.
+  if (((reinterpret_cast<uintptr_t>(dst) ^ reinterpret_cast<uintptr_t>(src)) & 15U) == 0) {
+    while (n > 0 && (reinterpret_cast<uintptr_t>(dst) & 15U) != 0) {
+      *dst++ = *src++;
+      --n;
+    }
+    if (n >= 8) {
+      const size_t blocks = n / 8;
+      copy565_blocks_(dst, src, blocks);
+      n -= blocks * 8;
+    }
+  }
+#endif
+  memcpy(dst, src, n * sizeof(uint16_t));
+}
+
+// Pseudo-random test pattern, deterministic across runs.
+void fill_pattern_(uint16_t *buf, size_t n, uint32_t seed) {
+  uint32_t x = seed * 2654435761U + 1U;
+  for (size_t i = 0; i < n; ++i) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    // Runs of repeated pixels exercise the blend cache.
+    buf[i] = (i % 7 < 3) ? 0x18C3 : static_cast<uint16_t>(x);
+  }
+}
+
+} // namespace
+
+void fill565Ref(uint16_t *dst, uint16_t color, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = color;
+  }
+}
+
+void blend565Ref(uint16_t *dst, size_t stride, size_t w, size_t h, uint16_t color, uint8_t opa) {
+  // fill_normal(), step by step: lv_color_mix() against black seeds the cache, then opa is
+  // rounded, lv_color_premult() and lv_color_mix_premult() with 255 - opa for every new background.
+  uint16_t last_bg = 0;
+  uint16_t last_res = blend_pixel_(spread565_(color), last_bg, mix5_(opa));
+  opa = premult_opa_(opa);
+  const uint16_t premult[3] = {
+      static_cast<uint16_t>((color >> 11) * opa),
+      static_cast<uint16_t>(((color >> 5) & 0x3FU) * opa),
+      static_cast<uint16_t>((color & 0x1FU) * opa),
+  };
+  const uint8_t opa_inv = static_cast<uint8_t>(255U - opa);
+  for (size_t y = 0; y < h; ++y) {
+    for (size_t x = 0; x < w; ++x) {
+      uint16_t &px = dst[y * stride + x];
+      if (px != last_bg) {
+        last_bg = px;
+        const uint32_t r = udiv255_(premult[0] + static_cast<uint32_t>(px >> 11) * opa_inv);
+        const uint32_t g = udiv255_(premult[1] + static_cast<uint32_t>((px >> 5) & 0x3FU) * opa_inv);
+        const uint32_t b = udiv255_(premult[2] + static_cast<uint32_t>(px & 0x1FU) * opa_inv);
+        last_res = static_cast<uint16_t>((r << 11) | (g << 5) | b);
+      }
+      px = last_res;
+    }
+  }
+}
+
+void swap565Ref(uint16_t *dst, const uint16_t *src, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = static_cast<uint16_t>((src[i] >> 8) | (src[i] << 8));
+  }
+}
+
+void copy565Ref(uint16_t *dst, const uint16_t *src, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+void fill565(uint16_t *dst, uint16_t color, size_t n) {
+  if (g_accelerated) {
+    fill565Words_(dst, color, n);
+  } else {
+    fill565Ref(dst, color, n);
+  }
+}
+
+void blend565(uint16_t *dst, size_t stride, size_t w, size_t h, uint16_t color, uint8_t opa) {
+  if (g_accelerated) {
+    blend565Scalar_(dst, stride, w, h, color, opa);
+  } else {
+    blend565Ref(dst, stride, w, h, color, opa);
+  }
+}
+
+void swap565(uint16_t *dst, const uint16_t *src, size_t n) {
+  if (g_accelerated) {
+    swap565Words_(dst, src, n);
+  } else {
+    swap565Ref(dst, src, n);
+  }
+}
+
+void copy565(uint16_t *dst, const uint16_t *src, size_t n) {
+  if (g_accelerated) {
+    copy565Memcpy_(dst, src, n);
+  } else {
+    copy565Ref(dst, src, n);
+  }
+}
+
+bool pixelKernelsAccelerated() { return g_accelerated; }
+
+bool pixelKernelsSelfTest(const char **failed) {
+  constexpr size_t kMax = 77;        // odd, covers head, vector blocks and tail
+  constexpr size_t kSlack = 8 + 1;   // room for every start offset
+  alignas(16) static uint16_t src[kMax + kSlack];
+  alignas(16) static uint16_t got[kMax + kSlack];
+  alignas(16) static uint16_t want[kMax + kSlack];
+  static const uint8_t kOpas[] = {0, 1, 7, 64, 127, 128, 200, 251, 252, 254, 255};
+
+  auto fail = [&](const char *name) {
+    g_accelerated = false;
+    if (failed != nullptr) *failed = name;
+    return false;
+  };
+
+  for (size_t off = 0; off < 8; ++off) {
+    for (size_t src_off = 0; src_off < 2; ++src_off) {
+      for (size_t n = 0; n <= kMax; n += (n < 20 ? 1 : 19)) {
+        fill_pattern_(src, kMax + kSlack, static_cast<uint32_t>(n + off * 131));
+        const uint16_t *s = src + off + src_off;
+
+        memcpy(got, src, sizeof(got));
+        memcpy(want, src, sizeof(want));
+        fill565Words_(got + off, s[0], n);
+        fill565Ref(want + off, s[0], n);
+        if (memcmp(got, want, sizeof(got)) != 0) return fail("fill565");
+
+        for (uint8_t opa : kOpas) {
+          // One row, then the same pixels as rows of 3 with a gap, so the cache spans rows.
+          memcpy(got, src, sizeof(got));
+          memcpy(want, src, sizeof(want));
+          blend565Scalar_(got + off, n, n, 1, s[1], opa);
+          blend565Ref(want + off, n, n, 1, s[1], opa);
+          if (memcmp(got, want, sizeof(got)) != 0) return fail("blend565");
+          blend565Scalar_(got + off, 4, 3, n / 4, s[2], opa);
+          blend565Ref(want + off, 4, 3, n / 4, s[2], opa);
+          if (memcmp(got, want, sizeof(got)) != 0) return fail("blend565");
+        }
+
+        memset(got, 0, sizeof(got));
+        memset(want, 0, sizeof(want));
+        swap565Words_(got + off, s, n);
+        swap565Ref(want + off, s, n);
+        if (memcmp(got, want, sizeof(got)) != 0) return fail("swap565");
+
+        memset(got, 0, sizeof(got));
+        memset(want, 0, sizeof(want));
+        copy565Memcpy_(got + off, s, n);
+        copy565Ref(want + off, s, n);
+        if (memcmp(got, want, sizeof(got)) != 0) return fail("copy565");
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace ws_lcd_35_s3_hal
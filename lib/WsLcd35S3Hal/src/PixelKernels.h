@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ws_lcd_35_s3_hal {
+
+// RGB565 pixel kernels for the LVGL draw hook (solid fill / opacity blend), the flush path
+// (byte swap) and the screenshot mirror (copy).
+//
+// Every kernel has a plain C++ reference (...Ref) that defines the exact result. The default
+// entry points are plain C++ as well: fill and swap move two pixels per 32-bit word, copy is
+// memcpy, and blend is the reference's scalar loop with the premultiply hoisted out. Only fill
+// and copy have vector code: ESP32-S3 PIE 128-bit stores/loads with -D ROVI_PIE_KERNELS=1,
+// which have not been built or run on hardware yet. pixelKernelsSelfTest() checks the entry
+// points against the references bit for bit and falls back to the references on a mismatch.
+
+// dst[i] = color
+void fill565(uint16_t *dst, uint16_t color, size_t n);
+void fill565Ref(uint16_t *dst, uint16_t color, size_t n);
+
+// color over an area of h rows of w pixels (rows `stride` pixels apart) with opacity opa, same
+// result as the unmasked, translucent case of LVGL 8's fill_normal() for 16-bit color with
+// LV_COLOR_MIX_ROUND_OFS 0, quirks included: opa is rounded to a multiple of 8 (252 wraps to 0)
+// for lv_color_mix_premult(), and the result is cached per background across the whole area,
+// starting from black with lv_color_mix() at the unrounded opa.
+void blend565(uint16_t *dst, size_t stride, size_t w, size_t h, uint16_t color, uint8_t opa);
+void blend565Ref(uint16_t *dst, size_t stride, size_t w, size_t h, uint16_t color, uint8_t opa);
+
+// dst[i] = byte-swapped src[i]; dst == src is allowed.
+void swap565(uint16_t *dst, const uint16_t *src, size_t n);
+void swap565Ref(uint16_t *dst, const uint16_t *src, size_t n);
+
+// dst[i] = src[i]; the ranges must not overlap.
+void copy565(uint16_t *dst, const uint16_t *src, size_t n);
+void copy565Ref(uint16_t *dst, const uint16_t *src, size_t n);
+
+// Runs every kernel and its reference over odd lengths and alignments and compares the
+// results. On a mismatch the kernels switch to the references and `failed` names the kernel.
+bool pixelKernelsSelfTest(const char **failed);
+bool pixelKernelsAccelerated();
+
+} // namespace ws_lcd_35_s3_hal
@@ -0,0 +1,80 @@
+#include "Rle565.h"
+
+namespace ws_lcd_35_s3_hal {
+namespace {
+
+static constexpr size_t kMaxPacketPixels = 128;
+static constexpr size_t kMinRunPixels = 3; // shorter runs are cheaper inside a literal
+
+inline void put_u16_(uint8_t *out, uint16_t v) {
+  out[0] = static_cast<uint8_t>(v & 0xFF);
+  out[1] = static_cast<uint8_t>((v >> 8) & 0xFF);
+}
+
+size_t put_literals_(const uint16_t *px, size_t count, uint8_t *out) {
+  size_t o = 0;
+  while (count > 0) {
+    const size_t n = (count > kMaxPacketPixels) ? kMaxPacketPixels : count;
+    out[o++] = static_cast<uint8_t>(n - 1);
+    for (size_t i = 0; i < n; ++i) {
+      put_u16_(out + o, px[i]);
+      o += 2;
+    }
+    px += n;
+    count -= n;
+  }
+  return o;
+}
+
+} // namespace
+
+void rle565WriteHeader(uint8_t *out, uint16_t width, uint16_t height) {
+  out[0] = 'R';
+  out[1] = '5';
+  out[2] = '6';
+  out[3] = '5';
+  out[4] = kRle565Version;
+  out[5] = 0;
+  put_u16_(out + 6, width);
+  put_u16_(out + 8, height);
+  out[10] = 0;
+  out[11] = 0;
+}
+
+size_t rle565EncodeRow(const uint16_t *row, size_t pixels, uint8_t *out) {
+  size_t o = 0;
+  size_t i = 0;
+  size_t lit_start = 0;
+  size_t lit_len = 0;
+
+  while (i < pixels) {
+    const uint16_t v = row[i];
+    size_t run = 1;
+    while (i + run < pixels && run < kMaxPacketPixels && row[i + run] == v) {
+      ++run;
+    }
+
+    if (run >= kMinRunPixels) {
+      if (lit_len > 0) {
+        o += put_literals_(row + lit_start, lit_len, out + o);
+        lit_len = 0;
+      }
+      out[o++] = static_cast<uint8_t>(0x80U | (run - 1));
+      put_u16_(out + o, v);
+      o += 2;
+    } else {
+      if (lit_len == 0) {
+        lit_start = i;
+      }
+      lit_len += run;
+    }
+    i += run;
+  }
+
+  if (lit_len > 0) {
+    o += put_literals_(row + lit_start, lit_len, out + o);
+  }
+  return o;
+}
+
+} // namespace ws_lcd_35_s3_hal
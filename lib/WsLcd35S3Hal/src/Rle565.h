@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ws_lcd_35_s3_hal {
+
+// RLE565: lossless run-length format for RGB565 screenshots.
+//
+// File layout (little-endian):
+//   header  "R565" | u8 version (1) | u8 reserved | u16 width | u16 height | u16 reserved
+//   rows    top-to-bottom, each row encoded independently as packets:
+//             0x80 | (n-1), u16 pixel        -> run of n (1..128) copies of pixel
+//             (n-1),        n * u16 pixels   -> n (1..128) literal pixels
+//
+// Rows never share packets, so the encoder only needs one row of working buffer.
+
+static constexpr size_t kRle565HeaderBytes = 12;
+static constexpr uint8_t kRle565Version = 1;
+
+// Worst case encoded size of a row of `pixels` pixels.
+constexpr size_t rle565MaxRowBytes(size_t pixels) { return pixels * 2U + pixels / 128U + 2U; }
+
+void rle565WriteHeader(uint8_t *out, uint16_t width, uint16_t height);
+
+// Encodes one row into `out` (at least rle565MaxRowBytes(pixels) bytes). Returns bytes written.
+size_t rle565EncodeRow(const uint16_t *row, size_t pixels, uint8_t *out);
+
+} // namespace ws_lcd_35_s3_hal
@@ -13,6 +13,8 @@
 #include <Arduino_GFX_Library.h>
 #include <lvgl.h>
 
+#include "PixelKernels.h"
+#include "Rle565.h"
 #include "TCA9554.h"
 #include "TouchDrvFT6X36.hpp"
 
@@ -25,8 +27,39 @@
 #ifndef ROVI_BENCH_DRAW_BUF
 #define ROVI_BENCH_DRAW_BUF 0
 #endif
+#ifndef ROVI_BENCH_KERNELS
+#define ROVI_BENCH_KERNELS 0
+#endif
+#ifndef ROVI_DIRECT_MODE
+#define ROVI_DIRECT_MODE 0
+#endif
+#ifndef ROVI_MERGE_OVERHEAD_PX
+#define ROVI_MERGE_OVERHEAD_PX 0
+#endif
+#ifndef ROVI_ADAPTIVE_RATES
+#define ROVI_ADAPTIVE_RATES 1
+#endif
+#ifndef ROVI_TOUCH_INT_PIN
+#define ROVI_TOUCH_INT_PIN -1
+#endif
+#ifndef ROVI_FLUSH_STATS
+#define ROVI_FLUSH_STATS 0
+#endif
+#ifndef ROVI_FLUSH_STATS_PERIOD_MS
+#define ROVI_FLUSH_STATS_PERIOD_MS 10000U
+#endif
 
 static constexpr bool kScreenshotsEnabled = (ROVI_ENABLE_SCREENSHOTS != 0);
+static constexpr bool kDirectMode = (ROVI_DIRECT_MODE != 0);
+static constexpr bool kAdaptiveRates = (ROVI_ADAPTIVE_RATES != 0);
+static constexpr bool kTouchIrq = (ROVI_TOUCH_INT_PIN >= 0);
+
+#if LV_COLOR_DEPTH != 8 && LV_COLOR_DEPTH != 16
+#error "WsLcd35S3Hal supports LV_COLOR_DEPTH 16 (RGB565) or 8 (RGB332, expanded while flushing)"
+#endif
+#if ROVI_DIRECT_MODE && LV_COLOR_DEPTH != 16
+#error "ROVI_DIRECT_MODE renders into an RGB565 frame; it cannot be combined with ROVI_COLOR_DEPTH_8"
+#endif
 
 namespace ws_lcd_35_s3_hal {
 namespace {
@@ -67,9 +100,289 @@ Arduino_ST7796 g_gfx(&g_bus, kLcdRst, 0 /* rotation */, true /* IPS? */, kLcdHor
 lv_disp_draw_buf_t g_draw_buf;
 lv_color_t *g_disp_draw_buf1 = nullptr;
 lv_color_t *g_disp_draw_buf2 = nullptr;
+
+#if LV_COLOR_DEPTH == 8 || ROVI_DIRECT_MODE
+// Small DMA bounce buffer the panel is fed from when the rendered pixels are not in DMA-capable
+// RAM in the panel's format (RGB332 draw buffers, or the PSRAM frame in direct mode).
+// kBounceLines * width * 2 bytes of internal RAM (12.5 KB at 320).
+static constexpr uint32_t kBounceLines = 20;
+uint16_t *g_bounce565 = nullptr;
+uint32_t g_bounce_pixels = 0;
+#endif
+
+#if LV_COLOR_DEPTH == 8
+// RGB332 draw buffers are expanded through this table into the bounce buffer.
+// The panel table holds the same colors byte-swapped (big-endian, the order the ST7796 takes),
+// so the bounce buffer goes out with draw16bitBeRGBBitmap and no per-pixel swap in the bus.
+uint16_t g_rgb332_to_565[256];
+uint16_t g_rgb332_to_565be[256];
+
+static void init_rgb332_lut_() {
+  for (uint32_t i = 0; i < 256; ++i) {
+    lv_color_t c;
+    c.full = static_cast<uint8_t>(i);
+    const uint32_t r = (c.ch.red * 31U + 3U) / 7U;
+    const uint32_t g = (c.ch.green * 63U + 3U) / 7U;
+    const uint32_t b = (c.ch.blue * 31U + 1U) / 3U;
+    g_rgb332_to_565[i] = static_cast<uint16_t>((r << 11) | (g << 5) | b);
+  }
+  swap565(g_rgb332_to_565be, g_rgb332_to_565, 256);
+}
+
+// Four pixels per step: one 32-bit load of RGB332 indices, two 32-bit stores of RGB565.
+// (There is no table-lookup/gather instruction to use here, so this is the wide form.)
+static void expand_rgb332_(const uint16_t *lut, const uint8_t *src, uint16_t *dst, uint32_t n) {
+  uint32_t i = 0;
+  if ((reinterpret_cast<uintptr_t>(src) & 3U) == 0 && (reinterpret_cast<uintptr_t>(dst) & 3U) == 0) {
+    const uint32_t *src4 = reinterpret_cast<const uint32_t *>(src);
+    uint32_t *dst2 = reinterpret_cast<uint32_t *>(dst);
+    for (; i + 4 <= n; i += 4) {
+      const uint32_t p = *src4++;
+      dst2[0] = lut[p & 0xFF] | (static_cast<uint32_t>(lut[(p >> 8) & 0xFF]) << 16);
+      dst2[1] = lut[(p >> 16) & 0xFF] | (static_cast<uint32_t>(lut[p >> 24]) << 16);
+      dst2 += 2;
+    }
+  }
+  for (; i < n; ++i) {
+    dst[i] = lut[src[i]];
+  }
+}
+#endif
+#if LV_COLOR_DEPTH == 16
+// LVGL's software blend with the solid-color cases (backgrounds, bars, text boxes without a
+// mask) routed to the pixel kernels; images, masked/anti-aliased edges and other blend modes
+// stay with lv_draw_sw_blend_basic.
+static void draw_blend_cb_(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc) {
+  const bool masked = dsc->mask_buf != nullptr && dsc->mask_res != LV_DRAW_MASK_RES_FULL_COVER;
+  if (dsc->src_buf != nullptr || masked || dsc->mask_res == LV_DRAW_MASK_RES_TRANSP ||
+      dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+    lv_draw_sw_blend_basic(draw_ctx, dsc);
+    return;
+  }
+  if (dsc->opa <= LV_OPA_MIN) {
+    return;
+  }
+
+  lv_area_t area;
+  if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) {
+    return;
+  }
+  const int32_t stride = lv_area_get_width(draw_ctx->buf_area);
+  const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&area));
+  uint16_t *row = reinterpret_cast<uint16_t *>(static_cast<lv_color_t *>(draw_ctx->buf)) +
+                  (area.y1 - draw_ctx->buf_area->y1) * stride + (area.x1 - draw_ctx->buf_area->x1);
+  if (dsc->opa < LV_OPA_MAX) {
+    blend565(row, stride, w, lv_area_get_height(&area), dsc->color.full, dsc->opa);
+    return;
+  }
+  for (int32_t y = area.y1; y <= area.y2; ++y) {
+    fill565(row, dsc->color.full, w);
+    row += stride;
+  }
+}
+
+static void draw_ctx_init_(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx) {
+  lv_draw_sw_init_ctx(drv, draw_ctx);
+  reinterpret_cast<lv_draw_sw_ctx_t *>(draw_ctx)->blend = draw_blend_cb_;
+}
+#endif
+
 lv_disp_drv_t g_disp_drv;
 lv_indev_drv_t g_indev_drv;
 
+#if ROVI_DIRECT_MODE
+// Direct mode: LVGL draws at absolute coordinates into one full RGB565 frame in PSRAM and only
+// the invalidated areas are re-rendered. PSRAM is not DMA-capable for the SPI bus, so each
+// dirty rectangle is copied row by row into the internal bounce buffer and pushed from there.
+static void push_frame_rect_(const uint16_t *frame, uint32_t frame_width, const lv_area_t &area) {
+  const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&area));
+  const uint32_t h = static_cast<uint32_t>(lv_area_get_height(&area));
+  const uint32_t chunk_lines = g_bounce_pixels / w;
+  for (uint32_t row = 0; row < h; row += chunk_lines) {
+    const uint32_t lines = (h - row) < chunk_lines ? (h - row) : chunk_lines;
+    const uint16_t *src = frame + (static_cast<uint32_t>(area.y1) + row) * frame_width + static_cast<uint32_t>(area.x1);
+    for (uint32_t i = 0; i < lines; ++i) {
+      copy565(g_bounce565 + i * w, src + i * frame_width, w);
+    }
+    g_gfx.draw16bitRGBBitmap(area.x1, area.y1 + static_cast<int16_t>(row), g_bounce565, w, lines);
+  }
+}
+#endif
+
+// Dirty-area merging. Every area LVGL flushes costs a panel window setup (CASET/RASET/RAMWR
+// plus the SPI transaction around them) on top of its pixels, so two nearby small areas can be
+// cheaper to send as their bounding box. The cost model counts the setup as
+// ROVI_MERGE_OVERHEAD_PX pixel transfers (calibrate with -D ROVI_BENCH_DRAW_BUF=1, which
+// prints setup_us / us_per_px); two areas are merged while their union adds at most that many
+// pixels over the two areas alone. 0 leaves LVGL's own joining (union smaller than the sum).
+static constexpr uint32_t kMergeOverheadPx = ROVI_MERGE_OVERHEAD_PX;
+lv_timer_cb_t g_lvgl_refr_timer_cb = nullptr;
+lv_timer_t *g_refr_timer = nullptr;
+lv_timer_t *g_indev_timer = nullptr;
+
+// Adaptive rates: refresh / touch read periods per mode. Active matches the lv_conf.h defaults. Idle is entered after kIdleAfterMs without invalidations or touches;
+// boost while the panel is touched (and kBoostHoldMs after release) or once kBurstTicks
+// refreshes in a row had something to redraw, each within kBurstWindowMs of the previous one.
+// LVGL pauses its refresh timer whenever nothing is dirty, so an update stream is recognized by
+// the spacing of dirty refreshes, not by ticks without dirty areas (those hardly ever run).
+struct RatePeriods {
+  uint32_t refr_ms;
+  uint32_t indev_ms;
+};
+static constexpr RatePeriods kRatePeriods[] = {
+    {100, 50},                                            // kIdle
+    {LV_DISP_DEF_REFR_PERIOD, LV_INDEV_DEF_READ_PERIOD}, // kActive
+    {15, 10},                                             // kBoost
+};
+static constexpr uint32_t kIdleAfterMs = 1000;
+static constexpr uint32_t kBoostHoldMs = 500;
+static constexpr uint32_t kBurstTicks = 3;
+static constexpr uint32_t kBurstWindowMs = LV_DISP_DEF_REFR_PERIOD + LV_DISP_DEF_REFR_PERIOD / 2;
+
+// Deadline-driven loop: waitForWork() blocks on the loop task's notification until the caller's
+// deadline, capped so polled jobs without a deadline of their own (RX line timeout, heap stats,
+// screenshot interval) still run. wake() / the touch interrupt end the wait early.
+static constexpr uint32_t kMaxWaitMs = 100;
+TaskHandle_t g_loop_task = nullptr;
+volatile bool g_touch_irq_pending = false;
+
+struct LoopTaskArgs {
+  WsLcd35S3Hal *hal;
+  WsLcd35S3Hal::TaskHook hook;
+  void *user;
+};
+LoopTaskArgs g_loop_task_args{};
+
+static void loop_task_(void *arg) {
+  const LoopTaskArgs *args = static_cast<const LoopTaskArgs *>(arg);
+  g_loop_task = xTaskGetCurrentTaskHandle();
+  for (;;) {
+    const uint32_t app_ms = args->hook != nullptr ? args->hook(args->user) : UINT32_MAX;
+    const uint32_t lvgl_ms = args->hal->runTimers();
+    args->hal->waitForWork(lvgl_ms < app_ms ? lvgl_ms : app_ms);
+  }
+}
+
+// Interrupt-driven touch: the FT6336 pulls INT low when it has touch data. While released the
+// read callback only talks I2C after an interrupt; while pressed it reads every period (10 ms in
+// boost) until the controller reports the release. g_touch_irq_us is the first interrupt since
+// the last read, for the touch-to-callback latency.
+volatile bool g_touch_data_pending = false;
+volatile uint32_t g_touch_irq_us = 0;
+volatile uint32_t g_touch_irqs = 0;
+
+static void IRAM_ATTR touch_isr_() {
+  g_touch_irq_pending = true;
+  g_touch_data_pending = true;
+  if (g_touch_irq_us == 0) {
+    g_touch_irq_us = micros() | 1U;
+  }
+  ++g_touch_irqs;
+  if (g_loop_task != nullptr) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(g_loop_task, &woken);
+    if (woken == pdTRUE) {
+      portYIELD_FROM_ISR();
+    }
+  }
+}
+
+static uint32_t merge_dirty_areas_(lv_disp_t *disp) {
+  uint32_t merged = 0;
+  while (disp->inv_p > 1) {
+    int32_t best_i = -1;
+    int32_t best_j = -1;
+    int32_t best_extra = 0;
+    lv_area_t best_union{};
+    for (int32_t i = 0; i < disp->inv_p; ++i) {
+      const uint32_t size_i = lv_area_get_size(&disp->inv_areas[i]);
+      for (int32_t j = i + 1; j < disp->inv_p; ++j) {
+        lv_area_t joined;
+        _lv_area_join(&joined, &disp->inv_areas[i], &disp->inv_areas[j]);
+        const int32_t extra = static_cast<int32_t>(lv_area_get_size(&joined)) -
+                              static_cast<int32_t>(size_i + lv_area_get_size(&disp->inv_areas[j]));
+        if (extra <= static_cast<int32_t>(kMergeOverheadPx) && (best_i < 0 || extra < best_extra)) {
+          best_i = i;
+          best_j = j;
+          best_extra = extra;
+          best_union = joined;
+        }
+      }
+    }
+    if (best_i < 0) {
+      break;
+    }
+    disp->inv_areas[best_i] = best_union;
+    for (int32_t k = best_j + 1; k < disp->inv_p; ++k) {
+      disp->inv_areas[k - 1] = disp->inv_areas[k];
+    }
+    --disp->inv_p;
+    ++merged;
+  }
+  return merged;
+}
+
+// Wraps LVGL's refresh timer so the dirty areas are merged before LVGL joins and renders them.
+static void refr_timer_cb_(lv_timer_t *timer) {
+  auto *disp = static_cast<lv_disp_t *>(timer->user_data);
+  if (disp != nullptr && disp->driver->user_data != nullptr && disp->act_scr != nullptr) {
+    // LVGL's refresh runs the pending layouts first, and they invalidate what moved. Run them
+    // here instead (the second pass inside the refresh is then a no-op) so those areas are merged
+    // and counted too.
+    lv_obj_update_layout(disp->act_scr);
+    if (disp->prev_scr != nullptr) {
+      lv_obj_update_layout(disp->prev_scr);
+    }
+    lv_obj_update_layout(disp->top_layer);
+    lv_obj_update_layout(disp->sys_layer);
+    const uint32_t areas = disp->inv_p;
+    const uint32_t merged = (kMergeOverheadPx > 0 && areas > 1) ? merge_dirty_areas_(disp) : 0;
+    static_cast<WsLcd35S3Hal *>(disp->driver->user_data)->onDirtyAreas_(areas, merged);
+  }
+  g_lvgl_refr_timer_cb(timer);
+}
+
+static void bench_pixel_kernels_() {
+#if ROVI_BENCH_KERNELS
+  // One 320x40 band, the size of a typical dirty strip, in internal RAM like the draw buffers.
+  constexpr uint32_t kPixels = 320U * 40U;
+  constexpr int kLoops = 50;
+  const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT;
+  auto *a = static_cast<uint16_t *>(heap_caps_aligned_alloc(16, kPixels * sizeof(uint16_t), caps));
+  auto *b = static_cast<uint16_t *>(heap_caps_aligned_alloc(16, kPixels * sizeof(uint16_t), caps));
+  if (a == nullptr || b == nullptr) {
+    Serial.println("BENCH kernels: alloc failed");
+    heap_caps_free(a);
+    heap_caps_free(b);
+    return;
+  }
+  for (uint32_t i = 0; i < kPixels; ++i) {
+    a[i] = static_cast<uint16_t>(i * 2654435761U >> 16);
+    b[i] = (i & 15U) < 12U ? 0x18C3 : a[i]; // mostly flat, like a tile background
+  }
+
+  auto run = [&](const char *label, auto &&fn) {
+    const uint32_t start = micros();
+    for (int i = 0; i < kLoops; ++i) {
+      fn();
+    }
+    const uint32_t elapsed = micros() - start;
+    const float mpx = (static_cast<float>(kPixels) * kLoops) / static_cast<float>(elapsed);
+    Serial.printf("BENCH %-12s %7.1f Mpx/s (%.1f MB/s)\n", label, mpx, mpx * 2.0f);
+  };
+  run("fill565", [&] { fill565(a, 0x1234, kPixels); });
+  run("fill565Ref", [&] { fill565Ref(a, 0x1234, kPixels); });
+  run("blend565", [&] { blend565(b, 320, 320, 40, 0xF800, 96); });
+  run("blend565Ref", [&] { blend565Ref(b, 320, 320, 40, 0xF800, 96); });
+  run("swap565", [&] { swap565(b, a, kPixels); });
+  run("swap565Ref", [&] { swap565Ref(b, a, kPixels); });
+  run("copy565", [&] { copy565(b, a, kPixels); });
+  run("copy565Ref", [&] { copy565Ref(b, a, kPixels); });
+  heap_caps_free(a);
+  heap_caps_free(b);
+#endif
+}
+
 static void bench_draw_buffers_(uint16_t screen_width, uint16_t screen_height) {
 #if ROVI_BENCH_DRAW_BUF
   const uint16_t w = screen_width;
@@ -105,6 +418,30 @@ static void bench_draw_buffers_(uint16_t screen_width, uint16_t screen_height) {
 
   bench("INTERNAL|DMA", MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
   bench("SPIRAM", MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+
+  // Window setup cost for the dirty-area merge model: one full-width strip versus many
+  // single-pixel windows, both from internal RAM.
+  uint16_t *strip = static_cast<uint16_t *>(heap_caps_malloc(w * sizeof(uint16_t) * 8U, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT));
+  if (strip != nullptr) {
+    constexpr int kWindows = 200;
+    memset(strip, 0x5A, w * sizeof(uint16_t) * 8U);
+    uint32_t start = micros();
+    for (int i = 0; i < kWindows; ++i) {
+      g_gfx.draw16bitRGBBitmap(0, 0, strip, 1, 1);
+    }
+    const float window_us = (micros() - start) / static_cast<float>(kWindows);
+    start = micros();
+    for (int i = 0; i < loops * 4; ++i) {
+      g_gfx.draw16bitRGBBitmap(0, 0, strip, w, 8);
+    }
+    const float us_per_px = (micros() - start) / static_cast<float>(loops * 4 * w * 8U);
+    const float setup_us = window_us - us_per_px;
+    Serial.printf("BENCH window: setup_us=%.2f us_per_px=%.4f -> -D ROVI_MERGE_OVERHEAD_PX=%u\n",
+                  setup_us,
+                  us_per_px,
+                  static_cast<unsigned>(setup_us > 0.0f ? setup_us / us_per_px : 0.0f));
+    heap_caps_free(strip);
+  }
 #else
   (void)screen_width;
   (void)screen_height;
@@ -121,10 +458,53 @@ void lcd_reset() {
 }
 
 static void disp_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
+#if ROVI_FLUSH_STATS
+  uint32_t start_us = micros();
+#endif
+#if ROVI_DIRECT_MODE
+  // Called once per invalidated area with the whole frame as the area; everything is pushed
+  // on the last call, from the areas LVGL kept after joining overlapping/adjacent ones.
+  (void)area;
+  if (!lv_disp_flush_is_last(disp_drv)) {
+    lv_disp_flush_ready(disp_drv);
+    return;
+  }
+  lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+  auto *hal = static_cast<WsLcd35S3Hal *>(disp_drv->user_data);
+  const auto *frame = reinterpret_cast<const uint16_t *>(color_p);
+  int32_t last_index = -1;
+  for (uint16_t i = 0; i < disp->inv_p; ++i) {
+    if (!disp->inv_area_joined[i]) last_index = i;
+  }
+  for (int32_t i = 0; i <= last_index; ++i) {
+    if (disp->inv_area_joined[i]) continue;
+    const lv_area_t &rect = disp->inv_areas[i];
+    push_frame_rect_(frame, static_cast<uint32_t>(disp_drv->hor_res), rect);
+    if (hal != nullptr) {
+#if ROVI_FLUSH_STATS
+      const uint32_t now_us = micros();
+      const uint32_t flush_us = now_us - start_us;
+      start_us = now_us;
+#else
+      const uint32_t flush_us = 0;
+#endif
+      hal->onFlush_(&rect, color_p, i == last_index, flush_us);
+    }
+  }
+  lv_disp_flush_ready(disp_drv);
+#else
   uint32_t w = static_cast<uint32_t>(area->x2 - area->x1 + 1);
   uint32_t h = static_cast<uint32_t>(area->y2 - area->y1 + 1);
 
-#if (LV_COLOR_16_SWAP != 0)
+#if LV_COLOR_DEPTH == 8
+  const uint8_t *src = &color_p->full;
+  const uint32_t chunk_lines = g_bounce_pixels / w; // whole rows per bounce buffer
+  for (uint32_t row = 0; row < h; row += chunk_lines) {
+    const uint32_t lines = (h - row) < chunk_lines ? (h - row) : chunk_lines;
+    expand_rgb332_(g_rgb332_to_565be, src + row * w, g_bounce565, lines * w);
+    g_gfx.draw16bitBeRGBBitmap(area->x1, area->y1 + static_cast<int16_t>(row), g_bounce565, w, lines);
+  }
+#elif (LV_COLOR_16_SWAP != 0)
   g_gfx.draw16bitBeRGBBitmap(area->x1, area->y1, reinterpret_cast<uint16_t *>(&color_p->full), w, h);
 #else
   g_gfx.draw16bitRGBBitmap(area->x1, area->y1, reinterpret_cast<uint16_t *>(&color_p->full), w, h);
@@ -132,15 +512,42 @@ static void disp_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_col
 
   if (disp_drv != nullptr && disp_drv->user_data != nullptr) {
     auto *hal = static_cast<WsLcd35S3Hal *>(disp_drv->user_data);
-    hal->copyAreaToMirror_(area, color_p);
+#if ROVI_FLUSH_STATS
+    const uint32_t flush_us = micros() - start_us;
+#else
+    const uint32_t flush_us = 0;
+#endif
+    hal->onFlush_(area, color_p, lv_disp_flush_is_last(disp_drv), flush_us);
   }
 
   lv_disp_flush_ready(disp_drv);
+#endif
 }
 
-static void touch_read_cb(lv_indev_drv_t *, lv_indev_data_t *data) {
+static void touch_read_cb(lv_indev_drv_t *indev_drv, lv_indev_data_t *data) {
+  static bool last_pressed = false;
+  auto *hal = (indev_drv != nullptr) ? static_cast<WsLcd35S3Hal *>(indev_drv->user_data) : nullptr;
+
+  if (kTouchIrq && !last_pressed && !g_touch_data_pending) {
+    // Released and no interrupt since: nothing new on the controller, skip the I2C read.
+    if (hal != nullptr) {
+      hal->onTouch_(false);
+    }
+    data->state = LV_INDEV_STATE_REL;
+    return;
+  }
+  g_touch_data_pending = false; // cleared before the read so an interrupt during it is kept
+  const uint32_t irq_us = g_touch_irq_us;
+  g_touch_irq_us = 0;
+
   int16_t x[1], y[1];
   uint8_t touched = g_touch.getPoint(x, y, 1);
+  last_pressed = (touched != 0);
+
+  if (hal != nullptr) {
+    hal->onTouchRead_(irq_us);
+    hal->onTouch_(touched != 0);
+  }
 
   if (touched) {
     data->state = LV_INDEV_STATE_PR;
@@ -277,18 +684,23 @@ bool WsLcd35S3Hal::begin() {
   if (kScreenshotsEnabled) {
     sd_mounted_ = initSdCard_();
     if (!sd_mounted_) {
-      Serial.println("WARN: SD card init failed (screenshots disabled)");
+      Serial.println("WARN: SD card init failed (SD screenshots disabled)");
     }
   }
 
+  const char *kernel_failed = nullptr;
+  if (!pixelKernelsSelfTest(&kernel_failed)) {
+    Serial.printf("WARN: %s self-test mismatch, using reference pixel kernels\n", kernel_failed);
+  }
+
   lv_init();
 
   screen_width_ = static_cast<uint16_t>(g_gfx.width());
   screen_height_ = static_cast<uint16_t>(g_gfx.height());
 
-  if (kScreenshotsEnabled && sd_mounted_) {
-    const uint32_t fb_bytes = static_cast<uint32_t>(screen_width_) * static_cast<uint32_t>(screen_height_) * sizeof(lv_color_t);
-    mirror_fb_ = static_cast<lv_color_t *>(heap_caps_malloc(fb_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (kScreenshotsEnabled && !kDirectMode) { // SD or serial capture; direct mode reads the frame itself
+    const uint32_t fb_bytes = static_cast<uint32_t>(screen_width_) * static_cast<uint32_t>(screen_height_) * sizeof(uint16_t);
+    mirror_fb_ = static_cast<uint16_t *>(heap_caps_malloc(fb_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
     if (mirror_fb_ == nullptr) {
       Serial.println("WARN: Screenshot mirror buffer alloc failed (PSRAM)");
     } else {
@@ -298,8 +710,32 @@ bool WsLcd35S3Hal::begin() {
 
   const uint32_t caps = (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
 
+#if LV_COLOR_DEPTH == 8 || ROVI_DIRECT_MODE
+  // Allocated before the draw buffers so they cannot take the room it needs.
+#if LV_COLOR_DEPTH == 8
+  init_rgb332_lut_();
+#endif
+  g_bounce_pixels = static_cast<uint32_t>(screen_width_) * kBounceLines;
+  g_bounce565 = static_cast<uint16_t *>(heap_caps_malloc(g_bounce_pixels * sizeof(uint16_t), caps));
+  if (g_bounce565 == nullptr) {
+    Serial.println("FATAL: RGB565 bounce buffer alloc failed");
+    return false;
+  }
+#endif
+
   uint32_t buf_lines = 0;
   bool double_buffered = false;
+#if ROVI_DIRECT_MODE
+  const uint32_t frame_bytes = static_cast<uint32_t>(screen_width_) * screen_height_ * sizeof(lv_color_t);
+  g_disp_draw_buf1 = static_cast<lv_color_t *>(heap_caps_malloc(frame_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (g_disp_draw_buf1 != nullptr) {
+    memset(g_disp_draw_buf1, 0, frame_bytes);
+    buf_lines = screen_height_;
+    if (kScreenshotsEnabled) {
+      mirror_fb_ = reinterpret_cast<uint16_t *>(g_disp_draw_buf1);
+    }
+  }
+#else
   for (uint32_t try_lines : {480U, 440U, 400U, 360U, 320U, 300U, 280U, 260U, 240U, 200U, 160U, 120U, 100U, 80U, 60U, 40U}) {
     if (try_lines > screen_height_) continue;
 
@@ -318,6 +754,7 @@ bool WsLcd35S3Hal::begin() {
     double_buffered = (buf2 != nullptr);
     break;
   }
+#endif
 
   if (g_disp_draw_buf1 == nullptr) {
     Serial.println("FATAL: LVGL draw buffers alloc failed");
@@ -333,8 +770,13 @@ bool WsLcd35S3Hal::begin() {
   };
   log_buf("buf1", g_disp_draw_buf1);
   log_buf("buf2", g_disp_draw_buf2);
-  Serial.printf("DRAW_BUF caps: INTERNAL|DMA\n");
-  Serial.printf("DRAW_BUF lines=%u mode=%s\n", static_cast<unsigned>(buf_lines), double_buffered ? "double" : "single");
+  Serial.printf("DRAW_BUF caps: %s\n", kDirectMode ? "SPIRAM (direct mode, full frame)" : "INTERNAL|DMA");
+  Serial.printf("DRAW_BUF lines=%u mode=%s depth=%u bytes=%u\n",
+                static_cast<unsigned>(buf_lines),
+                double_buffered ? "double" : "single",
+                static_cast<unsigned>(LV_COLOR_DEPTH),
+                static_cast<unsigned>(static_cast<uint32_t>(screen_width_) * buf_lines * sizeof(lv_color_t) *
+                                      (double_buffered ? 2U : 1U)));
   const uint32_t buf_pixels = static_cast<uint32_t>(screen_width_) * buf_lines;
   lv_disp_draw_buf_init(&g_draw_buf, g_disp_draw_buf1, g_disp_draw_buf2, buf_pixels);
 
@@ -344,13 +786,28 @@ bool WsLcd35S3Hal::begin() {
   g_disp_drv.flush_cb = disp_flush_cb;
   g_disp_drv.draw_buf = &g_draw_buf;
   g_disp_drv.user_data = this;
-  lv_disp_drv_register(&g_disp_drv);
+  g_disp_drv.direct_mode = kDirectMode ? 1 : 0;
+#if LV_COLOR_DEPTH == 16
+  g_disp_drv.draw_ctx_init = draw_ctx_init_;
+  g_disp_drv.draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+#endif
+  lv_disp_t *disp = lv_disp_drv_register(&g_disp_drv);
+  g_refr_timer = disp->refr_timer;
+  g_lvgl_refr_timer_cb = g_refr_timer->timer_cb;
+  lv_timer_set_cb(g_refr_timer, refr_timer_cb_);
 
   lv_indev_drv_init(&g_indev_drv);
   g_indev_drv.type = LV_INDEV_TYPE_POINTER;
   g_indev_drv.read_cb = touch_read_cb;
   g_indev_drv.user_data = this;
-  lv_indev_drv_register(&g_indev_drv);
+  lv_indev_t *indev = lv_indev_drv_register(&g_indev_drv);
+  g_indev_timer = indev->driver->read_timer;
+
+  g_loop_task = xTaskGetCurrentTaskHandle();
+  if (ROVI_TOUCH_INT_PIN >= 0) {
+    pinMode(ROVI_TOUCH_INT_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(ROVI_TOUCH_INT_PIN), touch_isr_, FALLING);
+  }
 
   if (flashfs_mounted_) {
     registerFlashFsWithLvgl_(lvgl_flash_drive_letter_);
@@ -359,13 +816,165 @@ bool WsLcd35S3Hal::begin() {
   }
 
   bench_draw_buffers_(screen_width_, screen_height_);
+  bench_pixel_kernels_();
+
+  return true;
+}
+
+void WsLcd35S3Hal::loop() { waitForWork(runTimers()); }
+
+uint32_t WsLcd35S3Hal::runTimers() {
+#if ROVI_FLUSH_STATS
+  const uint32_t handler_start_us = micros();
+#endif
+  uint32_t next_ms = lv_timer_handler();
+#if ROVI_FLUSH_STATS
+  flush_stats_.lvgl_us += micros() - handler_start_us;
+  printFlushStats_();
+#endif
+  if (kAdaptiveRates && updateRateMode_(millis())) {
+    next_ms = 0; // timer periods changed, the returned deadline may be too late
+  }
+  return next_ms;
+}
+
+void WsLcd35S3Hal::waitForWork(uint32_t max_ms) {
+  if (work_pending_) {
+    work_pending_ = false;
+    return;
+  }
+  if (max_ms > kMaxWaitMs) {
+    max_ms = kMaxWaitMs;
+  }
+  if (max_ms > 0) {
+#if ROVI_FLUSH_STATS
+    const uint32_t sleep_start_us = micros();
+#endif
+    const uint32_t notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(max_ms));
+#if ROVI_FLUSH_STATS
+    flush_stats_.sleep_us += micros() - sleep_start_us;
+    if (notified != 0) {
+      ++flush_stats_.wakeups;
+    }
+#else
+    (void)notified;
+#endif
+  }
+  if (g_touch_irq_pending) {
+    // Read the panel now instead of at the next poll period.
+    g_touch_irq_pending = false;
+    if (g_indev_timer != nullptr) {
+      lv_timer_ready(g_indev_timer);
+    }
+  }
+}
+
+void WsLcd35S3Hal::wake() {
+  if (g_loop_task != nullptr) {
+    xTaskNotifyGive(g_loop_task);
+  }
+}
 
+bool WsLcd35S3Hal::startTask(TaskHook hook, void *user, int core, uint32_t stack_bytes) {
+  if (g_loop_task_args.hal != nullptr) {
+    Serial.println("HAL: loop task already running");
+    return false;
+  }
+  g_loop_task_args = LoopTaskArgs{this, hook, user};
+  TaskHandle_t task = nullptr;
+  if (xTaskCreatePinnedToCore(loop_task_, "lvgl", stack_bytes, &g_loop_task_args, 1, &task, core) != pdPASS) {
+    g_loop_task_args = LoopTaskArgs{};
+    Serial.println("HAL: loop task creation failed");
+    return false;
+  }
+  g_loop_task = task;
+  return true;
+}
+
+const char *WsLcd35S3Hal::rateModeName(RateMode mode) {
+  switch (mode) {
+    case RateMode::kIdle:
+      return "idle";
+    case RateMode::kActive:
+      return "active";
+    case RateMode::kBoost:
+      return "boost";
+  }
+  return "?";
+}
+
+bool WsLcd35S3Hal::updateRateMode_(uint32_t now_ms) {
+  if (dirty_streak_ > 0 && now_ms - last_dirty_ms_ > kBurstWindowMs) {
+    dirty_streak_ = 0;
+  }
+  RateMode mode = RateMode::kIdle;
+  if (touch_down_ || now_ms - last_touch_ms_ < kBoostHoldMs || dirty_streak_ >= kBurstTicks) {
+    mode = RateMode::kBoost;
+  } else if (now_ms - last_dirty_ms_ < kIdleAfterMs) {
+    mode = RateMode::kActive;
+  }
+  if (mode == rate_mode_) {
+    return false;
+  }
+  rate_mode_ = mode;
+  const RatePeriods &periods = kRatePeriods[static_cast<uint8_t>(mode)];
+  if (g_refr_timer != nullptr) {
+    lv_timer_set_period(g_refr_timer, periods.refr_ms);
+  }
+  if (g_indev_timer != nullptr) {
+    lv_timer_set_period(g_indev_timer, periods.indev_ms);
+  }
+#if ROVI_FLUSH_STATS
+  ++flush_stats_.rate_switches;
+#endif
   return true;
 }
 
-void WsLcd35S3Hal::loop() {
-  lv_timer_handler();
-  delay(1);
+void WsLcd35S3Hal::printFlushStats_() {
+  const uint32_t now_ms = millis();
+  if (flush_stats_last_ms_ == 0) flush_stats_last_ms_ = now_ms;
+  if (now_ms - flush_stats_last_ms_ < ROVI_FLUSH_STATS_PERIOD_MS) {
+    return;
+  }
+  const uint32_t period_us = (now_ms - flush_stats_last_ms_) * 1000U;
+  flush_stats_last_ms_ = now_ms;
+
+  const FlushStats &s = flush_stats_;
+  const uint32_t refreshes = s.refreshes > 0 ? s.refreshes : 1U;
+  Serial.printf("FLUSH: mode=%s refreshes=%u flushes=%u flushes_per_refresh=%.2f areas=%u merged=%u px=%u spi_bytes=%u "
+                "flush_us=%u mirror_us=%u mirror_px=%u per_refresh_us=%u lvgl_us=%u per_refresh_lvgl_us=%u "
+                "rate=%s rate_switches=%u idle_pct=%.1f wakeups=%u\n",
+                kDirectMode ? "direct" : "striped",
+                static_cast<unsigned>(s.refreshes),
+                static_cast<unsigned>(s.flushes),
+                static_cast<double>(s.flushes) / refreshes,
+                static_cast<unsigned>(s.dirty_areas),
+                static_cast<unsigned>(s.merged_areas),
+                static_cast<unsigned>(s.pixels),
+                static_cast<unsigned>(s.pixels * sizeof(uint16_t)),
+                static_cast<unsigned>(s.flush_us),
+                static_cast<unsigned>(s.mirror_us),
+                static_cast<unsigned>(s.mirror_pixels),
+                static_cast<unsigned>(s.flush_us / refreshes),
+                static_cast<unsigned>(s.lvgl_us),
+                static_cast<unsigned>(s.lvgl_us / refreshes),
+                rateModeName(rate_mode_),
+                static_cast<unsigned>(s.rate_switches),
+                period_us > 0 ? 100.0 * s.sleep_us / period_us : 0.0,
+                static_cast<unsigned>(s.wakeups));
+
+  static uint32_t last_irqs = 0;
+  const uint32_t irqs = g_touch_irqs;
+  const float period_s = period_us > 0 ? period_us / 1e6f : 1.0f;
+  Serial.printf("TOUCH: mode=%s i2c_reads=%u i2c_reads_per_s=%.1f irqs=%u latency_us avg=%u max=%u\n",
+                kTouchIrq ? "irq" : "poll",
+                static_cast<unsigned>(s.touch_reads),
+                s.touch_reads / period_s,
+                static_cast<unsigned>(irqs - last_irqs),
+                static_cast<unsigned>(s.touch_latency_samples > 0 ? s.touch_latency_us / s.touch_latency_samples : 0U),
+                static_cast<unsigned>(s.touch_latency_max_us));
+  last_irqs = irqs;
+  resetFlushStats();
 }
 
 bool WsLcd35S3Hal::initDisplay_() {
@@ -409,8 +1018,195 @@ bool WsLcd35S3Hal::initSdCard_() {
   return true;
 }
 
-void WsLcd35S3Hal::copyAreaToMirror_(const lv_area_t *area, lv_color_t *color_p) {
-  if (!kScreenshotsEnabled) {
+bool WsLcd35S3Hal::requestCapture() {
+  if (!kScreenshotsEnabled || mirror_fb_ == nullptr) {
+    return false;
+  }
+  if (capture_state_ == CaptureState::kArmed) {
+    return true;
+  }
+
+  // The mirror is only written while armed, so force the next refresh to cover every pixel.
+  capture_state_ = CaptureState::kArmed;
+  lv_obj_invalidate(lv_scr_act());
+  return true;
+}
+
+void WsLcd35S3Hal::onFlush_(const lv_area_t *area, lv_color_t *color_p, bool last, uint32_t flush_us) {
+#if ROVI_FLUSH_STATS
+  ++flush_stats_.flushes;
+  if (area != nullptr) {
+    flush_stats_.pixels += static_cast<uint32_t>(lv_area_get_size(area));
+  }
+#endif
+
+  if (recording_ || capture_state_ == CaptureState::kArmed) {
+#if ROVI_FLUSH_STATS
+    const uint32_t mirror_start_us = micros();
+#endif
+    copyAreaToMirror_(area, color_p);
+    if (recording_) {
+      addDirtyRect_(area);
+    }
+#if ROVI_FLUSH_STATS
+    const uint32_t mirror_us = micros() - mirror_start_us;
+    flush_us += mirror_us;
+    flush_stats_.mirror_us += mirror_us;
+    if (area != nullptr) {
+      flush_stats_.mirror_pixels += static_cast<uint32_t>(lv_area_get_size(area));
+    }
+#endif
+    if (last && capture_state_ == CaptureState::kArmed) {
+      capture_state_ = CaptureState::kReady;
+      work_pending_ = true;
+    }
+  }
+
+#if ROVI_FLUSH_STATS
+  flush_stats_.flush_us += flush_us;
+  if (last) {
+    ++flush_stats_.refreshes;
+  }
+#else
+  (void)flush_us;
+#endif
+}
+
+void WsLcd35S3Hal::onTouch_(bool pressed) {
+  const uint32_t now_ms = millis();
+  if (pressed) {
+    last_touch_ms_ = now_ms;
+  }
+  if (!pressed) {
+    touch_down_ = false;
+    return;
+  }
+  if (!touch_down_) {
+    touch_down_ = true;
+    touch_down_ms_ = now_ms;
+    long_press_fired_ = false;
+    return;
+  }
+  if (long_press_ms_ > 0 && !long_press_fired_ && now_ms - touch_down_ms_ >= long_press_ms_) {
+    long_press_fired_ = true;
+    long_press_pending_ = true;
+    work_pending_ = true;
+  }
+}
+
+void WsLcd35S3Hal::onTouchRead_(uint32_t irq_us) {
+#if ROVI_FLUSH_STATS
+  ++flush_stats_.touch_reads;
+  if (irq_us != 0) {
+    const uint32_t latency_us = micros() - irq_us;
+    ++flush_stats_.touch_latency_samples;
+    flush_stats_.touch_latency_us += latency_us;
+    if (latency_us > flush_stats_.touch_latency_max_us) {
+      flush_stats_.touch_latency_max_us = latency_us;
+    }
+  }
+#else
+  (void)irq_us;
+#endif
+}
+
+void WsLcd35S3Hal::onDirtyAreas_(uint32_t areas, uint32_t merged) {
+  if (areas > 0) {
+    const uint32_t now_ms = millis();
+    dirty_streak_ = (dirty_streak_ > 0 && now_ms - last_dirty_ms_ <= kBurstWindowMs) ? dirty_streak_ + 1 : 1;
+    last_dirty_ms_ = now_ms;
+  } else {
+    dirty_streak_ = 0;
+  }
+#if ROVI_FLUSH_STATS
+  flush_stats_.dirty_areas += areas;
+  flush_stats_.merged_areas += merged;
+#else
+  (void)merged;
+#endif
+}
+
+bool WsLcd35S3Hal::takeLongPress() {
+  const bool pending = long_press_pending_;
+  long_press_pending_ = false;
+  return pending;
+}
+
+bool WsLcd35S3Hal::setRecording(bool enabled) {
+  if (enabled && (!kScreenshotsEnabled || mirror_fb_ == nullptr)) {
+    return false;
+  }
+  recording_ = enabled;
+  dirty_rect_count_ = 0;
+  if (enabled) {
+    lv_obj_invalidate(lv_scr_act());
+  }
+  return true;
+}
+
+void WsLcd35S3Hal::addDirtyRect_(const lv_area_t *area) {
+  if (area == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < dirty_rect_count_; ++i) {
+    if (_lv_area_is_in(area, &dirty_rects_[i], 0)) {
+      return;
+    }
+    if (_lv_area_is_in(&dirty_rects_[i], area, 0)) {
+      dirty_rects_[i] = *area;
+      return;
+    }
+  }
+  if (dirty_rect_count_ < kMaxDirtyRects) {
+    dirty_rects_[dirty_rect_count_++] = *area;
+    return;
+  }
+  // Out of slots: grow the last rectangle to cover the new one.
+  lv_area_t *tail = &dirty_rects_[kMaxDirtyRects - 1];
+  _lv_area_join(tail, tail, area);
+}
+
+size_t WsLcd35S3Hal::takeDirtyRects(lv_area_t *out, size_t max_rects) {
+  size_t n = dirty_rect_count_;
+  if (out == nullptr) {
+    n = 0;
+  } else if (n > max_rects) {
+    n = max_rects;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = dirty_rects_[i];
+  }
+  dirty_rect_count_ = 0;
+  return n;
+}
+
+bool WsLcd35S3Hal::writeRle565Rect(Print &out, const lv_area_t &area) {
+  if (!kScreenshotsEnabled || mirror_fb_ == nullptr) {
+    return false;
+  }
+  if (area.x1 < 0 || area.y1 < 0 || area.x2 >= screen_width_ || area.y2 >= screen_height_ || area.x2 < area.x1 ||
+      area.y2 < area.y1) {
+    return false;
+  }
+
+  const uint32_t w = static_cast<uint32_t>(area.x2 - area.x1 + 1);
+  std::unique_ptr<uint8_t[]> row(new (std::nothrow) uint8_t[rle565MaxRowBytes(w)]);
+  if (!row) {
+    return false;
+  }
+
+  for (lv_coord_t y = area.y1; y <= area.y2; ++y) {
+    const uint16_t *src = mirror_fb_ + (static_cast<uint32_t>(y) * screen_width_ + area.x1);
+    const size_t n = rle565EncodeRow(src, w, row.get());
+    if (out.write(row.get(), n) != n) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WsLcd35S3Hal::copyAreaToMirror_(const lv_area_t *area, const lv_color_t *color_p) {
+  if (!kScreenshotsEnabled || kDirectMode) { // in direct mode the mirror is the frame itself
     return;
   }
   if (mirror_fb_ == nullptr || area == nullptr || color_p == nullptr) {
@@ -422,13 +1218,17 @@ void WsLcd35S3Hal::copyAreaToMirror_(const lv_area_t *area, lv_color_t *color_p)
   const uint32_t stride_pixels = static_cast<uint32_t>(screen_width_);
   for (uint32_t row = 0; row < h; ++row) {
     const uint32_t dst_y = static_cast<uint32_t>(area->y1) + row;
-    lv_color_t *dst = mirror_fb_ + (dst_y * stride_pixels + static_cast<uint32_t>(area->x1));
+    uint16_t *dst = mirror_fb_ + (dst_y * stride_pixels + static_cast<uint32_t>(area->x1));
     const lv_color_t *src = color_p + (row * w);
-    memcpy(dst, src, w * sizeof(lv_color_t));
+#if LV_COLOR_DEPTH == 8
+    expand_rgb332_(g_rgb332_to_565, &src->full, dst, w);
+#else
+    copy565(dst, reinterpret_cast<const uint16_t *>(src), w);
+#endif
   }
 }
 
-bool WsLcd35S3Hal::writeBmp_(fs::File &file) {
+bool WsLcd35S3Hal::writeBmp_(Print &out) {
   if (!kScreenshotsEnabled || mirror_fb_ == nullptr) {
     return false;
   }
@@ -480,7 +1280,7 @@ bool WsLcd35S3Hal::writeBmp_(fs::File &file) {
   header[62] = static_cast<uint8_t>(kMaskB & 0xFF);
   header[63] = static_cast<uint8_t>((kMaskB >> 8) & 0xFF);
 
-  if (file.write(header, header_bytes) != header_bytes) {
+  if (out.write(header, header_bytes) != header_bytes) {
     return false;
   }
 
@@ -490,12 +1290,12 @@ bool WsLcd35S3Hal::writeBmp_(fs::File &file) {
   }
 
   for (int32_t y = static_cast<int32_t>(height) - 1; y >= 0; --y) { // BMP writes bottom-up
-    const lv_color_t *src = mirror_fb_ + (static_cast<uint32_t>(y) * width);
+    const uint16_t *src = mirror_fb_ + (static_cast<uint32_t>(y) * width);
     memcpy(row.get(), src, row_bytes);
     if (row_padded > row_bytes) {
       memset(row.get() + row_bytes, 0, row_padded - row_bytes);
     }
-    if (file.write(row.get(), row_padded) != row_padded) {
+    if (out.write(row.get(), row_padded) != row_padded) {
       return false;
     }
   }
@@ -503,7 +1303,55 @@ bool WsLcd35S3Hal::writeBmp_(fs::File &file) {
   return true;
 }
 
-bool WsLcd35S3Hal::captureScreenshotBmp(const char *path) {
+bool WsLcd35S3Hal::writeRle565_(Print &out) {
+  if (!kScreenshotsEnabled || mirror_fb_ == nullptr) {
+    return false;
+  }
+
+  const uint32_t width = screen_width_;
+  const uint32_t height = screen_height_;
+
+  uint8_t header[kRle565HeaderBytes];
+  rle565WriteHeader(header, static_cast<uint16_t>(width), static_cast<uint16_t>(height));
+  if (out.write(header, sizeof(header)) != sizeof(header)) {
+    return false;
+  }
+
+  const size_t row_cap = rle565MaxRowBytes(width);
+  std::unique_ptr<uint8_t[]> row(new (std::nothrow) uint8_t[row_cap]);
+  if (!row) {
+    return false;
+  }
+
+  for (uint32_t y = 0; y < height; ++y) {
+    const uint16_t *src = mirror_fb_ + (y * width);
+    const size_t n = rle565EncodeRow(src, width, row.get());
+    if (out.write(row.get(), n) != n) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const char *screenshotFileExtension(ScreenshotFormat format) {
+  switch (format) {
+    case ScreenshotFormat::kRle565:
+      return "r565";
+    case ScreenshotFormat::kBmp:
+    default:
+      return "bmp";
+  }
+}
+
+bool WsLcd35S3Hal::writeScreenshot(Print &out, ScreenshotFormat format) {
+  if (!kScreenshotsEnabled || mirror_fb_ == nullptr || capture_state_ != CaptureState::kReady) {
+    return false;
+  }
+  return (format == ScreenshotFormat::kRle565) ? writeRle565_(out) : writeBmp_(out);
+}
+
+bool WsLcd35S3Hal::captureScreenshot(const char *path, ScreenshotFormat format) {
   if (!kScreenshotsEnabled) {
     Serial.println("Screenshots disabled at compile time (ROVI_ENABLE_SCREENSHOTS=0)");
     return false;
@@ -516,6 +1364,10 @@ bool WsLcd35S3Hal::captureScreenshotBmp(const char *path) {
     Serial.println("Screenshot mirror buffer missing");
     return false;
   }
+  if (capture_state_ != CaptureState::kReady) {
+    Serial.println("Screenshot not ready (call requestCapture() and wait for a refresh)");
+    return false;
+  }
   if (path == nullptr || path[0] == '\0') {
     Serial.println("Invalid screenshot path");
     return false;
@@ -527,8 +1379,9 @@ bool WsLcd35S3Hal::captureScreenshotBmp(const char *path) {
     return false;
   }
 
-  const bool ok = writeBmp_(file);
+  const bool ok = writeScreenshot(file, format);
   file.close();
+  capture_state_ = CaptureState::kIdle;
   if (!ok) {
     Serial.println("Screenshot write failed");
   }
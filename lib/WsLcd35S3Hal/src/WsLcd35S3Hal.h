@@ -8,13 +8,55 @@
 
 namespace ws_lcd_35_s3_hal {
 
+enum class ScreenshotFormat : uint8_t {
+  kBmp,    // uncompressed 16-bit BMP (BI_BITFIELDS)
+  kRle565, // run-length encoded RGB565, see Rle565.h
+};
+
+const char *screenshotFileExtension(ScreenshotFormat format);
+
+// Flush-path counters (collected only with ROVI_FLUSH_STATS=1).
+struct FlushStats {
+  uint32_t refreshes = 0;  // completed refreshes (last flush seen)
+  uint32_t flushes = 0;    // disp_flush_cb calls
+  uint32_t pixels = 0;     // pixels pushed to the panel
+  uint32_t flush_us = 0;   // time spent in disp_flush_cb (incl. mirror copy)
+  uint32_t mirror_us = 0;  // part of flush_us spent copying into the screenshot mirror
+  uint32_t mirror_pixels = 0;
+  uint32_t dirty_areas = 0;  // invalidated areas handed to refreshes, before merging
+  uint32_t merged_areas = 0; // of those, merged into a neighbour by the cost model
+  uint32_t sleep_us = 0;     // time loop() spent sleeping; idle_pct is its share of the period
+  uint32_t rate_switches = 0;
+  uint32_t wakeups = 0;      // waits ended early by wake() or the touch interrupt
+  uint32_t touch_reads = 0;  // I2C reads of the touch controller
+  uint32_t touch_latency_us = 0; // sum over samples: touch interrupt -> read callback
+  uint32_t touch_latency_max_us = 0;
+  uint32_t touch_latency_samples = 0;
+  uint32_t lvgl_us = 0;    // time in lv_timer_handler (render + flush), i.e. total frame time
+};
+
 class WsLcd35S3Hal {
 public:
   WsLcd35S3Hal();
 
   bool begin();
+  // runTimers() then waitForWork() with LVGL's deadline only.
   void loop();
 
+  // Event-driven main loop: runTimers() runs the LVGL timers and returns the milliseconds until
+  // the next one is due; waitForWork() sleeps until the given deadline (at most 100 ms), wake(),
+  // the touch interrupt (-DROVI_TOUCH_INT_PIN=<gpio>) or HAL work such as a ready capture.
+  uint32_t runTimers();
+  void waitForWork(uint32_t max_ms);
+  void wake(); // task context (e.g. serial RX callbacks), not from ISRs
+
+  // Moves the loop into its own FreeRTOS task pinned to `core`. Each pass calls hook(user)
+  // (application work that touches LVGL; returns its own deadline in ms, UINT32_MAX for none),
+  // then runTimers() and waitForWork() until the earlier deadline. wake() and the touch
+  // interrupt then target that task, and from then on only it may call LVGL.
+  using TaskHook = uint32_t (*)(void *user);
+  bool startTask(TaskHook hook, void *user, int core = 1, uint32_t stack_bytes = 8192);
+
   uint16_t width() const { return screen_width_; }
   uint16_t height() const { return screen_height_; }
 
@@ -25,15 +67,58 @@ public:
 
   char lvglFlashDriveLetter() const { return lvgl_flash_drive_letter_; }
 
-  bool captureScreenshotBmp(const char *path);
-  void copyAreaToMirror_(const lv_area_t *area, lv_color_t *color_p); // internal: called from flush_cb
+  // Screenshot capture is on-demand: requestCapture() invalidates the whole screen and the
+  // next complete refresh is copied into the mirror. Outside of a request the flush path
+  // does not touch the mirror at all.
+  bool requestCapture();
+  bool captureReady() const { return capture_state_ == CaptureState::kReady; }
+  bool capturePending() const { return capture_state_ != CaptureState::kIdle; }
+  bool captureScreenshot(const char *path, ScreenshotFormat format); // requires captureReady(), releases it
+  bool writeScreenshot(Print &out, ScreenshotFormat format);          // requires captureReady(), keeps it
+  void releaseCapture() { capture_state_ = CaptureState::kIdle; }
+  bool captureScreenshotBmp(const char *path) { return captureScreenshot(path, ScreenshotFormat::kBmp); }
+
+  // Delta recording: while enabled every flush is mirrored and its area is remembered, so a
+  // recorder can store only the rectangles that changed since the last takeDirtyRects().
+  // Enabling it invalidates the whole screen so the first batch is a full keyframe.
+  static constexpr size_t kMaxDirtyRects = 32;
+  bool setRecording(bool enabled);
+  bool recording() const { return recording_; }
+  size_t takeDirtyRects(lv_area_t *out, size_t max_rects);
+  bool writeRle565Rect(Print &out, const lv_area_t &area); // RLE565 rows of `area` from the mirror
+
+  // Long-press detection on the raw touch input (anywhere on the panel). takeLongPress()
+  // returns true once per press that was held for at least the configured time (0 = off).
+  void setLongPressMs(uint32_t hold_ms) { long_press_ms_ = hold_ms; }
+  bool takeLongPress();
+
+  // Adaptive LVGL rates (-DROVI_ADAPTIVE_RATES, default on): refresh and touch polling slow down
+  // while nothing is invalidated or touched and speed up while touched or during update bursts.
+  enum class RateMode : uint8_t { kIdle, kActive, kBoost };
+  RateMode rateMode() const { return rate_mode_; }
+  static const char *rateModeName(RateMode mode);
+
+  const FlushStats &flushStats() const { return flush_stats_; }
+  void resetFlushStats() { flush_stats_ = FlushStats{}; }
+
+  void onFlush_(const lv_area_t *area, lv_color_t *color_p, bool last, uint32_t flush_us); // internal: called from flush_cb
+  void onTouch_(bool pressed);                                                               // internal: called from touch read_cb
+  void onDirtyAreas_(uint32_t areas, uint32_t merged);                                       // internal: called from the refresh timer
+  void onTouchRead_(uint32_t irq_us);                                                        // internal: called from touch read_cb
 
 private:
   bool initDisplay_();
   bool initTouch_();
   bool initFlashFs_();
   bool initSdCard_();
-  bool writeBmp_(fs::File &file);
+  enum class CaptureState : uint8_t { kIdle, kArmed, kReady };
+
+  void copyAreaToMirror_(const lv_area_t *area, const lv_color_t *color_p);
+  void addDirtyRect_(const lv_area_t *area);
+  void printFlushStats_();
+  bool updateRateMode_(uint32_t now_ms);
+  bool writeBmp_(Print &out);
+  bool writeRle565_(Print &out);
   void registerFlashFsWithLvgl_(char drive_letter);
 
   uint16_t screen_width_ = 0;
@@ -43,7 +128,23 @@ private:
   fs::FS *flash_fs_ = nullptr;
   bool sd_mounted_ = false;
   fs::FS *sd_fs_ = nullptr;
-  lv_color_t *mirror_fb_ = nullptr;
+  uint16_t *mirror_fb_ = nullptr; // RGB565 regardless of LV_COLOR_DEPTH
+  CaptureState capture_state_ = CaptureState::kIdle;
+  bool recording_ = false;
+  lv_area_t dirty_rects_[kMaxDirtyRects]{};
+  size_t dirty_rect_count_ = 0;
+  uint32_t long_press_ms_ = 0;
+  uint32_t touch_down_ms_ = 0;
+  bool touch_down_ = false;
+  bool long_press_fired_ = false;
+  bool long_press_pending_ = false;
+  volatile bool work_pending_ = false;
+  RateMode rate_mode_ = RateMode::kActive;
+  uint32_t last_dirty_ms_ = 0;
+  uint32_t last_touch_ms_ = 0;
+  uint32_t dirty_streak_ = 0; // dirty refreshes in a row, each within the burst window of the last
+  FlushStats flush_stats_{};
+  uint32_t flush_stats_last_ms_ = 0;
   char lvgl_flash_drive_letter_ = 'F';
 };
 
@@ -2,6 +2,7 @@
  *Be sure to read the docs here: https://docs.lvgl.io/master/get-started/platforms/arduino.html  */
 
 #include <Arduino.h>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 
@@ -17,6 +18,14 @@
 
 #include "rovi_serial_rx_stats.h"
 
+#if defined(ARDUINO_ARCH_ESP32) && ARDUINO_USB_CDC_ON_BOOT
+#if !ARDUINO_USB_MODE
+#include "USBCDC.h"
+#else
+#include "HWCDC.h"
+#endif
+#endif
+
 #ifndef ROVI_ENABLE_JSONL_DEMO_REPLAY
 #define ROVI_ENABLE_JSONL_DEMO_REPLAY 0
 #endif
@@ -38,13 +47,102 @@
 #define ROVI_RX_ERROR_HEX_DUMP 0
 #endif
 
-static constexpr const char *kConfigPath = "/config.json";
+// Periodic heap report for long-running soak checks: free / largest block / fragmentation of
+// the internal heap (where LVGL's LV_MEM_CUSTOM malloc puts small objects). 0 disables.
+#ifndef ROVI_HEAP_STATS_PERIOD_MS
+#define ROVI_HEAP_STATS_PERIOD_MS 0U
+#endif
+
+// Soak verdict: bytes the largest free block / min_free may fall below the baseline (the second
+// report, after the first period of updates) before a report says FAIL.
+#ifndef ROVI_HEAP_SOAK_TOLERANCE
+#define ROVI_HEAP_SOAK_TOLERANCE 0U
+#endif
+
+// Dashboard config on FFat; e.g. -D ROVI_CONFIG_PATH=\"/config_hz24.json\" for the 24-row bench config.
+#ifndef ROVI_CONFIG_PATH
+#define ROVI_CONFIG_PATH "/config.json"
+#endif
+
+// Threaded mode: LVGL rendering and flushing, the dashboard tick and screenshots run in their
+// own task on core 1; serial ingestion and parsing run in a task on core 0. Widget updates
+// cross over through the dashboard's lock-free update queue. 0 keeps the single loop().
+#ifndef ROVI_LVGL_TASK
+#define ROVI_LVGL_TASK 0
+#endif
+
+// Update throughput bench: publishes this many updates per pass, round-robin over all widgets,
+// from the ingest side (loop() or the ingest task), and prints what was applied per period.
+#ifndef ROVI_BENCH_UPDATES
+#define ROVI_BENCH_UPDATES 0
+#endif
+
+#ifndef ROVI_BENCH_UPDATES_PERIOD_MS
+#define ROVI_BENCH_UPDATES_PERIOD_MS 5000U
+#endif
+
+static constexpr const char *kConfigPath = ROVI_CONFIG_PATH;
 
 static ws_lcd_35_s3_hal::WsLcd35S3Hal g_hal;
 static live_dashboard::LiveDashboard g_dashboard;
 static screenshot::ScreenshotController g_shots(g_hal, g_dashboard);
 static bool g_dashboard_ready = false;
 
+#if ROVI_LVGL_TASK
+static TaskHandle_t g_ingest_task = nullptr;
+static std::atomic<int> g_ui_bind_state{0}; // 1 once the dashboard is bound to the LVGL task, -1 on failure
+
+// Screenshot commands touch LVGL, so the ingest task hands them to the LVGL task.
+static char g_ui_command[16]{};
+static std::atomic<bool> g_ui_command_pending{false};
+
+// A !snap frame is binary on the same Serial the ingest task logs to. The LVGL task holds this
+// for the whole frame, the ingest task for each pass, so no log line lands inside a frame.
+static SemaphoreHandle_t g_serial_lock = nullptr;
+
+static void serial_guard(bool hold, void *) {
+  if (hold) {
+    xSemaphoreTake(g_serial_lock, portMAX_DELAY);
+  } else {
+    xSemaphoreGive(g_serial_lock);
+  }
+}
+#endif
+
+// Serial RX wakes the task that parses it (the main loop, or the ingest task in threaded mode).
+// g_rx_event_us marks the first RX event since the port was last drained, for the
+// input-to-apply latency in the RX stats.
+static volatile uint32_t g_rx_event_us = 0;
+
+static void note_serial_rx() {
+  if (g_rx_event_us == 0) {
+    g_rx_event_us = micros() | 1U;
+  }
+#if ROVI_LVGL_TASK
+  if (g_ingest_task != nullptr) {
+    xTaskNotifyGive(g_ingest_task);
+  }
+#else
+  g_hal.wake();
+#endif
+}
+
+#if defined(ARDUINO_ARCH_ESP32) && ARDUINO_USB_CDC_ON_BOOT
+static void serial_rx_wake_cb(void *, esp_event_base_t, int32_t, void *) { note_serial_rx(); }
+#endif
+
+static void register_serial_wakeup() {
+#if defined(ARDUINO_ARCH_ESP32) && ARDUINO_USB_CDC_ON_BOOT
+#if !ARDUINO_USB_MODE
+  Serial.onEvent(ARDUINO_USB_CDC_RX_EVENT, serial_rx_wake_cb);
+#else
+  Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, serial_rx_wake_cb);
+#endif
+#elif defined(ARDUINO_ARCH_ESP32)
+  Serial.onReceive([]() { note_serial_rx(); });
+#endif
+}
+
 static void touch_allocation(void *ptr, size_t size) {
   if (ptr == nullptr || size == 0) {
     return;
@@ -135,23 +233,143 @@ static void print_malloc_probe(const char *tag) {
 #endif
 }
 
+static void print_heap_stats_periodic() {
+#if defined(ARDUINO_ARCH_ESP32)
+  if (ROVI_HEAP_STATS_PERIOD_MS == 0) {
+    return;
+  }
+  static uint32_t last_ms = 0;
+  const uint32_t now_ms = millis();
+  if (last_ms != 0 && now_ms - last_ms < ROVI_HEAP_STATS_PERIOD_MS) {
+    return;
+  }
+  last_ms = now_ms;
+
+  constexpr uint32_t kCaps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+  const size_t free_bytes = heap_caps_get_free_size(kCaps);
+  const size_t largest = heap_caps_get_largest_free_block(kCaps);
+  const size_t min_free = heap_caps_get_minimum_free_size(kCaps);
+  const unsigned frag_pct = free_bytes > 0 ? static_cast<unsigned>(100U - (largest * 100U) / free_bytes) : 0U;
+  Serial.printf("HEAP: uptime=%us internal free=%u largest=%u frag=%u%% min_free=%u spiram free=%u\n",
+                static_cast<unsigned>(now_ms / 1000U),
+                static_cast<unsigned>(free_bytes),
+                static_cast<unsigned>(largest),
+                frag_pct,
+                static_cast<unsigned>(min_free),
+                static_cast<unsigned>(heap_caps_get_free_size(MALLOC_CAP_SPIRAM)));
+
+  static uint32_t reports = 0;
+  static size_t base_largest = 0;
+  static size_t base_min_free = 0;
+  if (++reports < 2) {
+    return;
+  }
+  if (reports == 2) {
+    base_largest = largest;
+    base_min_free = min_free;
+    Serial.printf("HEAP: soak baseline largest=%u min_free=%u\n",
+                  static_cast<unsigned>(base_largest),
+                  static_cast<unsigned>(base_min_free));
+    return;
+  }
+  if (largest + ROVI_HEAP_SOAK_TOLERANCE < base_largest || min_free + ROVI_HEAP_SOAK_TOLERANCE < base_min_free) {
+    Serial.printf("HEAP: soak FAIL largest=%u (baseline %u) min_free=%u (baseline %u)\n",
+                  static_cast<unsigned>(largest),
+                  static_cast<unsigned>(base_largest),
+                  static_cast<unsigned>(min_free),
+                  static_cast<unsigned>(base_min_free));
+  } else {
+    Serial.println("HEAP: soak ok");
+  }
+#endif
+}
+
 static void rovi_action_cb(const char *action_id, void *) {
   Serial.printf("ROVI action requested: %s\n", action_id != nullptr ? action_id : "(null)");
 }
 
-static void poll_event_lines_from_serial() {
-  static char rx[1024 + 1]{};
+static bool handle_ui_command(const char *line) {
+#if ROVI_LVGL_TASK
+  if (line[0] != '!' || strlen(line) >= sizeof(g_ui_command)) {
+    return false;
+  }
+  if (g_ui_command_pending.load(std::memory_order_acquire)) {
+    Serial.printf("CMD: %s dropped (previous command still pending)\n", line);
+    return true;
+  }
+  strcpy(g_ui_command, line);
+  g_ui_command_pending.store(true, std::memory_order_release);
+  g_hal.wake();
+  return true;
+#else
+  return g_shots.handleCommand(line);
+#endif
+}
+
+#if ROVI_BENCH_UPDATES
+static void bench_publish_updates() {
+  static size_t next_widget = 0;
+  static uint32_t published = 0;
+  static uint32_t last_ms = 0;
+  static live_dashboard::LiveDashboardUpdateStats last_stats{};
+
+  const size_t widgets = g_dashboard.widgetCount();
+  if (widgets == 0) {
+    return;
+  }
+  for (uint32_t i = 0; i < ROVI_BENCH_UPDATES; ++i) {
+    const char *id = g_dashboard.widgetId(next_widget);
+    next_widget = (next_widget + 1) % widgets;
+    if (g_dashboard.publishGauge(id, static_cast<int32_t>(published % 100U), nullptr)) {
+      ++published;
+    }
+  }
+
+  const uint32_t now_ms = millis();
+  if (last_ms == 0) {
+    last_ms = now_ms;
+    return;
+  }
+  const uint32_t elapsed_ms = now_ms - last_ms;
+  if (elapsed_ms < ROVI_BENCH_UPDATES_PERIOD_MS) {
+    return;
+  }
+  // Single loop: every publish is applied in place. Threaded: applied by the LVGL task's tick().
+  const live_dashboard::LiveDashboardUpdateStats stats = g_dashboard.updateStats();
+  const uint32_t applied = ROVI_LVGL_TASK ? stats.applied - last_stats.applied : published;
+  Serial.printf("BENCH updates: mode=%s published/s=%u applied/s=%u dropped=%u max_depth=%u\n",
+                ROVI_LVGL_TASK ? "task" : "loop",
+                static_cast<unsigned>((static_cast<uint64_t>(published) * 1000U) / elapsed_ms),
+                static_cast<unsigned>((static_cast<uint64_t>(applied) * 1000U) / elapsed_ms),
+                static_cast<unsigned>(stats.dropped - last_stats.dropped),
+                static_cast<unsigned>(stats.max_depth));
+  published = 0;
+  last_stats = stats;
+  last_ms = now_ms;
+}
+#endif
+
+// Returns true if any serial input was consumed.
+static bool poll_event_lines_from_serial() {
+  static constexpr size_t kRxLineMax = 1024;
+  static char rx[kRxLineMax + 1]{};
   static size_t rx_len = 0;
   static bool rx_drop = false;
+  static bool rx_stream = false;          // current line is JSON, fed to the dashboard as it arrives
+  static bool rx_stream_overflow = false; // ...and no longer fits in rx (no fallback parse)
   static uint32_t last_rx_ms = 0;
   static uint32_t last_stats_ms = 0;
 
   static uint32_t ok_lines = 0;
+  static uint32_t stream_lines = 0;
   static uint32_t ingest_fail = 0;
   static uint32_t overflow_count = 0;
   static uint32_t timeout_count = 0;
   static uint32_t resync_count = 0;
   static uint32_t dropped_bytes = 0;
+  static uint32_t apply_samples = 0;
+  static uint32_t apply_us_sum = 0;
+  static uint32_t apply_us_max = 0;
 
   auto dump_ascii = [&](const char *label, const char *buf, size_t len, bool suffix) {
     if (buf == nullptr) return;
@@ -210,15 +428,22 @@ static void poll_event_lines_from_serial() {
     const uint32_t now_ms = millis();
     if (last_stats_ms == 0) last_stats_ms = now_ms;
     if (now_ms - last_stats_ms >= ROVI_RX_STATS_PERIOD_MS) {
-      Serial.printf("EVENT: RX stats ok=%u fail=%u overflow=%u timeout=%u resync=%u dropped=%u rx_len=%u drop=%u\n",
+      Serial.printf("EVENT: RX stats ok=%u stream=%u fail=%u overflow=%u timeout=%u resync=%u dropped=%u rx_len=%u drop=%u "
+                    "apply_us avg=%u max=%u\n",
                     static_cast<unsigned>(ok_lines),
+                    static_cast<unsigned>(stream_lines),
                     static_cast<unsigned>(ingest_fail),
                     static_cast<unsigned>(overflow_count),
                     static_cast<unsigned>(timeout_count),
                     static_cast<unsigned>(resync_count),
                     static_cast<unsigned>(dropped_bytes),
                     static_cast<unsigned>(rx_len),
-                    rx_drop ? 1U : 0U);
+                    rx_drop ? 1U : 0U,
+                    static_cast<unsigned>(apply_samples > 0 ? apply_us_sum / apply_samples : 0U),
+                    static_cast<unsigned>(apply_us_max));
+      apply_samples = 0;
+      apply_us_sum = 0;
+      apply_us_max = 0;
       last_stats_ms = now_ms;
     }
   }
@@ -226,74 +451,209 @@ static void poll_event_lines_from_serial() {
 
   // Drain UART RX buffer first. Timeout is handled after draining to avoid false positives
   // when the main loop is busy (bytes can be queued in the UART while we're not reading).
-  while (Serial.available() > 0) {
-    int c = Serial.read();
-    if (c < 0) {
+  //
+  // JSON lines ('{' or '[') are streamed into the dashboard as they arrive, so long arrays
+  // are applied item by item and are never dropped for length. They are also buffered while
+  // they fit, which lets the dashboard fall back to a full JSON parse for unusual input.
+  const uint32_t rx_event_us = g_rx_event_us;
+  g_rx_event_us = 0;
+  const uint32_t ok_before = ok_lines;
+  bool consumed = false;
+
+  char chunk[128];
+  int avail = 0;
+  while ((avail = Serial.available()) > 0) {
+    const size_t want = (static_cast<size_t>(avail) < sizeof(chunk)) ? static_cast<size_t>(avail) : sizeof(chunk);
+    const size_t n = Serial.read(reinterpret_cast<uint8_t *>(chunk), want);
+    if (n == 0) {
       break;
     }
     last_rx_ms = millis();
+    consumed = true;
 
-    // Accept LF, CR, or CRLF as line terminators.
-    if (c == '\n' || c == '\r') {
-      if (rx_drop) {
-        ++resync_count;
-        Serial.printf("EVENT: RX resynced after dropping %u bytes\n", static_cast<unsigned>(dropped_bytes));
-        dropped_bytes = 0;
-      } else {
-        rx[rx_len] = '\0';
-        if (rx_len > 0) {
-          if (g_dashboard.ingestLine(rx)) {
+    size_t stream_from = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const char c = chunk[i];
+
+      // Accept LF, CR, or CRLF as line terminators.
+      if (c == '\n' || c == '\r') {
+        if (rx_stream) {
+          g_dashboard.feedEventStream(chunk + stream_from, i - stream_from);
+          rx[rx_len] = '\0';
+          if (g_dashboard.endEventStream(rx_stream_overflow ? nullptr : rx)) {
             ++ok_lines;
           } else {
             ++ingest_fail;
           }
+          ++stream_lines;
+        } else if (rx_drop) {
+          ++resync_count;
+          Serial.printf("EVENT: RX resynced after dropping %u bytes\n", static_cast<unsigned>(dropped_bytes));
+          dropped_bytes = 0;
+        } else {
+          rx[rx_len] = '\0';
+          if (rx_len > 0) {
+            if (handle_ui_command(rx)) {
+              ++ok_lines;
+            } else if (g_dashboard.ingestLine(rx)) {
+              ++ok_lines;
+            } else {
+              ++ingest_fail;
+            }
+          }
+        }
+        rx_len = 0;
+        rx_drop = false;
+        rx_stream = false;
+        rx_stream_overflow = false;
+        continue;
+      }
+
+      if (rx_drop) {
+        ++dropped_bytes;
+        continue;
+      }
+
+      if (rx_len == 0 && !rx_stream) {
+        if (c == ' ' || c == '\t') {
+          continue;
+        }
+        if (c == '{' || c == '[') {
+          rx_stream = true;
+          stream_from = i;
+          g_dashboard.beginEventStream();
         }
       }
-      rx_len = 0;
-      rx_drop = false;
-      continue;
-    }
 
-    if (rx_drop) {
-      ++dropped_bytes;
-      continue;
+      if (rx_len < kRxLineMax) {
+        rx[rx_len++] = c;
+      } else if (rx_stream) {
+        rx_stream_overflow = true;
+      } else {
+        ++overflow_count;
+        Serial.printf("EVENT: RX line too long (max %u), dropping (rx_len=%u overflow=%u)\n",
+                      static_cast<unsigned>(kRxLineMax),
+                      static_cast<unsigned>(rx_len),
+                      static_cast<unsigned>(overflow_count));
+        dump_ascii("buffer", rx, rx_len, false);
+        dump_ascii("buffer", rx, rx_len, true);
+        dump_hex("buffer", rx, rx_len, false);
+        dump_hex("buffer", rx, rx_len, true);
+        rx_len = 0;
+        rx_drop = true;
+        dropped_bytes = 0;
+      }
     }
 
-    if (rx_len < 1024) {
-      rx[rx_len++] = static_cast<char>(c);
-    } else {
-      ++overflow_count;
-      Serial.printf("EVENT: RX line too long (max 1024), dropping (rx_len=%u overflow=%u)\n",
-                    static_cast<unsigned>(rx_len),
-                    static_cast<unsigned>(overflow_count));
-      dump_ascii("buffer", rx, rx_len, false);
-      dump_ascii("buffer", rx, rx_len, true);
-      dump_hex("buffer", rx, rx_len, false);
-      dump_hex("buffer", rx, rx_len, true);
-      rx_len = 0;
-      rx_drop = true;
-      dropped_bytes = 0;
+    if (rx_stream) {
+      g_dashboard.feedEventStream(chunk + stream_from, n - stream_from);
     }
   }
 
+  // Input-to-apply latency: first RX event of this batch until its lines were ingested.
+  if (rx_event_us != 0 && ok_lines != ok_before) {
+    const uint32_t apply_us = micros() - rx_event_us;
+    ++apply_samples;
+    apply_us_sum += apply_us;
+    if (apply_us > apply_us_max) apply_us_max = apply_us;
+  }
+
   // If a line started but no new bytes arrive for a while, reset so we don't wedge forever.
   // Note: we base this on "time since last byte *read*", so it must run after draining.
   if ((rx_len > 0 || rx_drop) && last_rx_ms != 0 && ROVI_RX_LINE_TIMEOUT_MS > 0) {
     const uint32_t now_ms = millis();
     if (now_ms - last_rx_ms > ROVI_RX_LINE_TIMEOUT_MS) {
-      Serial.printf("EVENT: RX line timeout, resetting (len=%u drop=%u)\n",
+      Serial.printf("EVENT: RX line timeout, resetting (len=%u drop=%u stream=%u)\n",
                     static_cast<unsigned>(rx_len),
-                    rx_drop ? 1U : 0U);
+                    rx_drop ? 1U : 0U,
+                    rx_stream ? 1U : 0U);
       ++timeout_count;
+      if (rx_stream) {
+        // Items already streamed stay applied; the unterminated tail is discarded.
+        g_dashboard.endEventStream(nullptr);
+      }
       rx_len = 0;
       rx_drop = false;
+      rx_stream = false;
+      rx_stream_overflow = false;
       dropped_bytes = 0;
     }
   }
+  return consumed;
+}
+
+#if ROVI_LVGL_TASK
+// LVGL task (core 1), before every lv_timer_handler() pass.
+static uint32_t lvgl_task_hook(void *) {
+  if (g_ui_bind_state.load(std::memory_order_relaxed) == 0) {
+    g_ui_bind_state.store(g_dashboard.bindToCurrentTask() ? 1 : -1, std::memory_order_release);
+  }
+  if (g_ui_command_pending.load(std::memory_order_acquire)) {
+    if (!g_shots.handleCommand(g_ui_command)) {
+      g_dashboard.ingestLine(g_ui_command);
+    }
+    g_ui_command_pending.store(false, std::memory_order_release);
+  }
+  g_dashboard.tick();
+  g_shots.tick();
+  return g_dashboard.msUntilNextTick();
+}
+
+// Ingest task (core 0): parses serial input into queued widget updates and wakes the LVGL task.
+static void ingest_task(void *) {
+  for (;;) {
+    serial_guard(true, nullptr);
+    rovi::serial_rx_stats::tick();
+    const bool consumed = poll_event_lines_from_serial();
+    print_heap_stats_periodic();
+#if ROVI_BENCH_UPDATES
+    bench_publish_updates();
+#endif
+    serial_guard(false, nullptr);
+#if ROVI_BENCH_UPDATES
+    (void)consumed;
+    g_hal.wake();
+    vTaskDelay(1);
+#else
+    if (consumed) {
+      g_hal.wake();
+    }
+    // Capped like the HAL's wait, for the RX line timeout and the periodic reports.
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+#endif
+  }
+}
+
+static bool start_tasks() {
+  g_serial_lock = xSemaphoreCreateMutex();
+  if (g_serial_lock == nullptr) {
+    Serial.println("FATAL: serial lock creation failed");
+    return false;
+  }
+  g_shots.setSerialGuard(serial_guard, nullptr);
+  if (!g_hal.startTask(lvgl_task_hook, nullptr, 1)) {
+    return false;
+  }
+  // Publishing from core 0 is only safe once the dashboard knows its UI task.
+  int bind_state = 0;
+  while ((bind_state = g_ui_bind_state.load(std::memory_order_acquire)) == 0) {
+    delay(1);
+  }
+  if (bind_state < 0) {
+    Serial.println("FATAL: dashboard could not bind to the LVGL task");
+    return false;
+  }
+  if (xTaskCreatePinnedToCore(ingest_task, "ingest", 8192, nullptr, 1, &g_ingest_task, 0) != pdPASS) {
+    Serial.println("FATAL: ingest task creation failed");
+    return false;
+  }
+  return true;
 }
+#endif
 
 void setup() {
   rovi::serial_rx_stats::configure_before_serial_begin();
+  register_serial_wakeup();
   Serial.begin(115200);
   Serial.println("ROVI dashboard (config-driven) example");
   print_memory_stats("boot");
@@ -332,19 +692,44 @@ void setup() {
   Serial.println("Setup done");
 
   g_shots.begin();
+
+#if ROVI_LVGL_TASK
+  if (!start_tasks()) {
+    while (true) {
+      delay(1000);
+    }
+  }
+  serial_guard(true, nullptr);
+  Serial.println("LVGL task on core 1, ingest task on core 0");
+  serial_guard(false, nullptr);
+#endif
 }
 
+// Event-driven: each pass does the due work, then sleeps until the earlier of LVGL's next
+// timer and the dashboard's next stale/demo deadline, or until serial RX / touch wakes it.
 void loop() {
-  rovi::serial_rx_stats::tick();
-
   if (!g_dashboard_ready) {
+    rovi::serial_rx_stats::tick();
     g_hal.loop();
     return;
   }
 
+#if ROVI_LVGL_TASK
+  // Both halves run in their own tasks.
+  vTaskDelete(nullptr);
+#else
+  rovi::serial_rx_stats::tick();
   g_dashboard.tick();
   g_shots.tick();
   poll_event_lines_from_serial();
+  print_heap_stats_periodic();
+#if ROVI_BENCH_UPDATES
+  bench_publish_updates();
+#endif
 
-  g_hal.loop();
+  const uint32_t lvgl_ms = g_hal.runTimers();
+  const uint32_t dashboard_ms = g_dashboard.msUntilNextTick();
+  // The update bench keeps publishing, so it never sleeps.
+  g_hal.waitForWork(ROVI_BENCH_UPDATES ? 0U : (lvgl_ms < dashboard_ms ? lvgl_ms : dashboard_ms));
+#endif
 }
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""Reconstruct frames from a delta recording (replay.rvd) and write PNGs and/or a GIF.
+
+Usage:
+  tools/delta_replay.py run_4/replay.rvd --gif render.gif [--png-dir frames/] [--scale 0.5]
+
+The recording is written by ScreenshotController in CaptureMode::kDelta
+(-DROVI_SCREENSHOT_RECORD=1). Layout (little-endian):
+
+  header  "RVDS" | u8 version | u8 reserved | u16 width | u16 height | u16 reserved
+  frame   u32 frame_index | u32 t_ms | u16 rect_count
+          rect_count x (u16 x | u16 y | u16 w | u16 h | h RLE565 rows of w pixels)
+
+The first frame carries the full screen (keyframe). Only the standard library is used.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import screenshot_decode  # noqa: E402
+
+
+def read_frames(data):
+    """Yields (frame_index, t_ms, width, height, framebuffer); the framebuffer is updated in place."""
+    if data[:4] != b"RVDS":
+        raise ValueError("not a delta recording")
+    if data[4] != 1:
+        raise ValueError("unsupported delta version %d" % data[4])
+    width, height = struct.unpack_from("<HH", data, 6)
+    fb = [0] * (width * height)
+    pos = 12
+    while pos + 10 <= len(data):
+        frame_index, t_ms, rect_count = struct.unpack_from("<IIH", data, pos)
+        pos += 10
+        for _ in range(rect_count):
+            x, y, w, h = struct.unpack_from("<HHHH", data, pos)
+            pos += 8
+            for row in range(h):
+                px, pos = screenshot_decode.decode_rle565_row(data, pos, w)
+                start = (y + row) * width + x
+                fb[start:start + w] = px
+        yield frame_index, t_ms, width, height, fb
+
+
+def scaled_rows(fb, width, height, scale):
+    step = max(1, int(round(1.0 / scale))) if scale < 1.0 else 1
+    rows = []
+    for y in range(0, height, step):
+        base = y * width
+        rows.append(fb[base:base + width:step])
+    return rows
+
+
+class GifWriter:
+    """Minimal animated GIF encoder (global palette, LZW, no transparency)."""
+
+    def __init__(self, path, width, height):
+        self.f = open(path, "wb")
+        self.width = width
+        self.height = height
+        self.palette = []
+        self.index = {}
+        self.frames = []
+
+    def add(self, rows, delay_cs):
+        self.frames.append(([list(r) for r in rows], max(2, delay_cs)))
+
+    def _build_palette(self):
+        counts = {}
+        for rows, _ in self.frames:
+            for r in rows:
+                for v in r:
+                    counts[v] = counts.get(v, 0) + 1
+        colors = sorted(counts, key=counts.get, reverse=True)
+        self.palette = colors[:256]
+        self.index = {v: i for i, v in enumerate(self.palette)}
+        rgb = [screenshot_decode.rgb565_to_rgb888(v) for v in self.palette]
+        for v in colors[256:]:
+            r, g, b = screenshot_decode.rgb565_to_rgb888(v)
+            self.index[v] = min(
+                range(len(rgb)), key=lambda i: (rgb[i][0] - r) ** 2 + (rgb[i][1] - g) ** 2 + (rgb[i][2] - b) ** 2
+            )
+
+    @staticmethod
+    def _lzw(indices, min_code_size):
+        clear = 1 << min_code_size
+        eoi = clear + 1
+        out = bytearray()
+        state = {"buf": 0, "len": 0, "size": min_code_size + 1, "next": eoi + 1}
+
+        def emit(code):
+            state["buf"] |= code << state["len"]
+            state["len"] += state["size"]
+            while state["len"] >= 8:
+                out.append(state["buf"] & 0xFF)
+                state["buf"] >>= 8
+                state["len"] -= 8
+            # Same code-width schedule as giflib: widen once the next free code no longer fits.
+            if state["next"] >= (1 << state["size"]) and state["size"] < 12:
+                state["size"] += 1
+
+        def reset():
+            state["size"] = min_code_size + 1
+            state["next"] = eoi + 1
+            return {(i,): i for i in range(clear)}
+
+        table = reset()
+        emit(clear)
+        seq = ()
+        for px in indices:
+            cand = seq + (px,)
+            if cand in table:
+                seq = cand
+                continue
+            emit(table[seq])
+            if state["next"] >= 4095:
+                emit(clear)
+                table = reset()
+            else:
+                table[cand] = state["next"]
+                state["next"] += 1
+            seq = (px,)
+        if seq:
+            emit(table[seq])
+        emit(eoi)
+        if state["len"]:
+            out.append(state["buf"] & 0xFF)
+        return bytes(out)
+
+    def close(self):
+        self._build_palette()
+        f = self.f
+        f.write(b"GIF89a")
+        f.write(struct.pack("<HHBBB", self.width, self.height, 0xF7, 0, 0))  # 256-entry global table
+        pal = bytearray()
+        for v in self.palette:
+            pal.extend(screenshot_decode.rgb565_to_rgb888(v))
+        pal.extend(b"\x00" * (768 - len(pal)))
+        f.write(pal)
+        f.write(b"\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00")  # loop forever
+        for rows, delay_cs in self.frames:
+            f.write(struct.pack("<BBBBHBB", 0x21, 0xF9, 4, 0, delay_cs, 0, 0))
+            f.write(struct.pack("<BHHHHB", 0x2C, 0, 0, self.width, self.height, 0))
+            indices = [self.index[v] for r in rows for v in r]
+            data = self._lzw(indices, 8)
+            f.write(b"\x08")
+            for i in range(0, len(data), 255):
+                block = data[i:i + 255]
+                f.write(bytes([len(block)]) + block)
+            f.write(b"\x00")
+        f.write(b"\x3B")
+        f.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("recording")
+    parser.add_argument("--png-dir", default=None, help="write every frame as PNG into this directory")
+    parser.add_argument("--gif", default=None, help="write an animated GIF")
+    parser.add_argument("--scale", type=float, default=1.0, help="GIF downscale factor (e.g. 0.5)")
+    args = parser.parse_args()
+
+    with open(args.recording, "rb") as f:
+        data = f.read()
+
+    if args.png_dir:
+        os.makedirs(args.png_dir, exist_ok=True)
+
+    gif = None
+    prev_t = None
+    pending = None
+    frames = 0
+    for frame_index, t_ms, width, height, fb in read_frames(data):
+        frames += 1
+        if args.png_dir:
+            out = os.path.join(args.png_dir, "frame_%05u.png" % frame_index)
+            screenshot_decode.write_png(out, width, height, [fb[y * width:(y + 1) * width] for y in range(height)])
+        if args.gif:
+            rows = scaled_rows(fb, width, height, args.scale)
+            if gif is None:
+                gif = GifWriter(args.gif, len(rows[0]), len(rows))
+            if pending is not None:
+                gif.add(pending, (t_ms - prev_t) // 10)
+            pending = rows
+            prev_t = t_ms
+    if gif is not None and pending is not None:
+        gif.add(pending, 100)
+        gif.close()
+
+    print("%s: %u frames, %u bytes" % (args.recording, frames, len(data)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,133 @@
+// Host events/s of the event line scanner against ArduinoJson on a demo file, the same loop as
+// the firmware's -D LIVE_DASHBOARD_BENCH_PARSER=1 boot bench (lib/LiveDashboard/src/LiveDashboard.cpp).
+//
+// Usage: event_scanner_bench [data/test.jsonl]
+// The ArduinoJson run is compiled in when <ArduinoJson.h> is on the include path (run.sh adds
+// .pio/libdeps/*/ArduinoJson/src or $ARDUINOJSON_INCLUDE); otherwise only the scanner is timed.
+// Host numbers compare the two parsers; they say nothing about the ESP32-S3's absolute rate.
+
+#include "EventScanner.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if __has_include(<ArduinoJson.h>)
+#include <ArduinoJson.h>
+#define BENCH_ARDUINOJSON 1
+#else
+#define BENCH_ARDUINOJSON 0
+#endif
+
+using namespace live_dashboard;
+
+namespace {
+
+constexpr size_t kEventLineMaxLen = 1024; // as in LiveDashboard.cpp
+constexpr double kRunSeconds = 1.0;
+
+bool count_sink(const EventScanner::Event &event, void *user) {
+  // Touch the fields so both parsers do comparable work.
+  uint32_t *acc = static_cast<uint32_t *>(user);
+  *acc += static_cast<uint32_t>(event.value) + (event.id != nullptr ? static_cast<uint8_t>(event.id[0]) : 0U) +
+          (event.text != nullptr ? static_cast<uint8_t>(event.text[0]) : 0U);
+  return true;
+}
+
+template <typename ParseLine>
+void run(const char *label, const std::vector<std::string> &lines, ParseLine parse_line) {
+  using Clock = std::chrono::steady_clock;
+  uint64_t events = 0;
+  uint32_t passes = 0;
+  const Clock::time_point start = Clock::now();
+  double elapsed = 0.0;
+  do {
+    for (const std::string &line : lines) {
+      events += parse_line(line);
+    }
+    ++passes;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < kRunSeconds);
+
+  std::printf("event_scanner_bench %s: %llu events in %u passes, %.1f ms, %.0f events/s (%.3f us/event)\n", label,
+              static_cast<unsigned long long>(events), passes, elapsed * 1e3, events / elapsed,
+              events > 0 ? elapsed * 1e6 / events : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const char *path = argc > 1 ? argv[1] : "data/test.jsonl";
+  FILE *f = std::fopen(path, "r");
+  if (f == nullptr) {
+    std::printf("event_scanner_bench: cannot open %s\n", path);
+    return 1;
+  }
+  std::vector<std::string> lines;
+  size_t bytes = 0;
+  char buf[kEventLineMaxLen + 2];
+  while (std::fgets(buf, sizeof(buf), f) != nullptr) {
+    size_t n = std::strlen(buf);
+    while (n > 0 && (buf[n - 1] == '\n' || buf[n - 1] == '\r')) {
+      buf[--n] = '\0';
+    }
+    if (n == 0 || n > kEventLineMaxLen) {
+      continue;
+    }
+    lines.emplace_back(buf, n);
+    bytes += n;
+  }
+  std::fclose(f);
+  if (lines.empty()) {
+    std::printf("event_scanner_bench: no lines in %s\n", path);
+    return 1;
+  }
+  std::printf("event_scanner_bench: %zu lines, %zu bytes from %s\n", lines.size(), bytes, path);
+
+  uint32_t acc = 0;
+  EventScanner scanner;
+  run("scanner", lines, [&](const std::string &line) -> size_t {
+    scanner.begin(&count_sink, &acc);
+    scanner.feed(line.data(), line.size());
+    return scanner.dispatched();
+  });
+
+#if BENCH_ARDUINOJSON
+  // Same zero-copy mode and document size as ingestion, which modifies the input.
+  static StaticJsonDocument<JSON_ARRAY_SIZE((kEventLineMaxLen + 1) / 2)> doc;
+  char scratch[kEventLineMaxLen + 1];
+  run("ArduinoJson", lines, [&](const std::string &line) -> size_t {
+    std::memcpy(scratch, line.c_str(), line.size() + 1);
+    if (deserializeJson(doc, scratch)) {
+      return 0;
+    }
+    size_t events = 0;
+    auto visit = [&](JsonObject obj) {
+      const char *id = obj["id"];
+      const char *text = obj["text"];
+      const EventScanner::Event event{
+          EventScanner::Kind::kItem, id, text, obj["value"].is<int32_t>(), obj["value"].as<int32_t>(), 0};
+      count_sink(event, &acc);
+      ++events;
+    };
+    JsonVariant root = doc.as<JsonVariant>();
+    if (root.is<JsonArray>()) {
+      for (JsonVariant v : root.as<JsonArray>()) {
+        visit(v.as<JsonObject>());
+      }
+    } else {
+      visit(root.as<JsonObject>());
+    }
+    return events;
+  });
+#else
+  std::printf("event_scanner_bench ArduinoJson: skipped (<ArduinoJson.h> not on the include path)\n");
+#endif
+
+  // Keeps the sink's work from being optimized away.
+  std::printf("event_scanner_bench: checksum %u\n", static_cast<unsigned>(acc));
+  return 0;
+}
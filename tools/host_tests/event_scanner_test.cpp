@@ -0,0 +1,244 @@
+// Host check of the event line scanner (lib/LiveDashboard/src/EventScanner.h): items and
+// snapshots fed whole and in chunks, escapes, int32 bounds, and the inputs that must stop it
+// with kUnsupported so LiveDashboard falls back to ArduinoJson.
+// Run with tools/host_tests/run.sh.
+
+#include "EventScanner.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace live_dashboard;
+
+namespace {
+
+struct Seen {
+  EventScanner::Kind kind;
+  bool has_id;
+  std::string id;
+  bool has_text;
+  std::string text;
+  bool has_value;
+  int32_t value;
+  size_t index;
+
+  bool operator==(const Seen &o) const {
+    return kind == o.kind && has_id == o.has_id && id == o.id && has_text == o.has_text && text == o.text &&
+           has_value == o.has_value && value == o.value && index == o.index;
+  }
+};
+
+struct Recorder {
+  std::vector<Seen> seen;
+  bool accept_snapshot = true;
+  const char *reject_id = nullptr; // items with this id are reported as not applied
+};
+
+bool record_sink(const EventScanner::Event &event, void *user) {
+  Recorder *r = static_cast<Recorder *>(user);
+  Seen s{event.kind,
+         event.id != nullptr,
+         event.id != nullptr ? event.id : "",
+         event.text != nullptr,
+         event.text != nullptr ? event.text : "",
+         event.has_value,
+         event.value,
+         event.index};
+  r->seen.push_back(s);
+  if (event.kind == EventScanner::Kind::kSnapshotBegin) {
+    return r->accept_snapshot;
+  }
+  return r->reject_id == nullptr || event.id == nullptr || std::strcmp(event.id, r->reject_id) != 0;
+}
+
+Seen item(const char *id, const char *text, bool has_value, int32_t value) {
+  return Seen{EventScanner::Kind::kItem, id != nullptr, id != nullptr ? id : "", text != nullptr,
+              text != nullptr ? text : "", has_value, value, 0};
+}
+
+Seen snap_item(size_t index, const char *text, bool has_value, int32_t value) {
+  return Seen{EventScanner::Kind::kSnapshotItem, false, "", text != nullptr, text != nullptr ? text : "",
+              has_value, value, index};
+}
+
+Seen snap_begin(const char *cfg) {
+  return Seen{EventScanner::Kind::kSnapshotBegin, false, "", true, cfg, false, 0, 0};
+}
+
+int g_failures = 0;
+
+void check(bool ok, const char *what) {
+  if (!ok) {
+    std::printf("FAIL: %s\n", what);
+    ++g_failures;
+  }
+}
+
+struct Result {
+  EventScanner::Status status;
+  size_t dispatched;
+  size_t applied;
+  std::vector<Seen> seen;
+};
+
+// Feeds `line` in chunks of `chunk` bytes (0 = all at once).
+Result scan(const char *line, size_t chunk = 0, Recorder recorder = Recorder()) {
+  EventScanner scanner;
+  scanner.begin(&record_sink, &recorder);
+  const size_t len = std::strlen(line);
+  if (chunk == 0) {
+    scanner.feed(line, len);
+  } else {
+    for (size_t off = 0; off < len; off += chunk) {
+      scanner.feed(line + off, len - off < chunk ? len - off : chunk);
+    }
+  }
+  return Result{scanner.status(), scanner.dispatched(), scanner.applied(), recorder.seen};
+}
+
+void expect(const char *line, EventScanner::Status status, const std::vector<Seen> &seen, const char *what) {
+  const Result r = scan(line);
+  if (r.status != status || r.seen != seen) {
+    std::printf("FAIL: %s (status %d, %zu events) for %s\n", what, static_cast<int>(r.status), r.seen.size(), line);
+    ++g_failures;
+  }
+}
+
+void expect_unsupported(const char *line, size_t dispatched, const char *what) {
+  const Result r = scan(line);
+  if (r.status != EventScanner::Status::kUnsupported || r.dispatched != dispatched) {
+    std::printf("FAIL: %s (status %d, dispatched %zu, want %zu) for %s\n", what, static_cast<int>(r.status),
+                r.dispatched, dispatched, line);
+    ++g_failures;
+  }
+}
+
+} // namespace
+
+int main() {
+  using Status = EventScanner::Status;
+
+  // Keyed items, in any key order, with missing fields left unset.
+  expect("{\"id\":\"cpu\",\"value\":12,\"text\":\"12%\"}", Status::kDone, {item("cpu", "12%", true, 12)},
+         "single item");
+  expect(" {\"text\":\"down\" , \"id\" : \"net\"}\r\n", Status::kDone, {item("net", "down", false, 0)},
+         "whitespace and key order");
+  expect("[{\"id\":\"a\",\"value\":-3},{\"id\":\"b\"},{}]", Status::kDone,
+         {item("a", nullptr, true, -3), item("b", nullptr, false, 0), item(nullptr, nullptr, false, 0)}, "array");
+  expect("[]", Status::kDone, {}, "empty array");
+  expect("{\"id\":\"a\",\"value\":1", Status::kNeedMore, {}, "unclosed object");
+
+  // Escapes are decoded; \u is not.
+  expect("{\"id\":\"e\",\"text\":\"a\\\"b\\\\c\\/d\\n\\t\\r\\b\\f\"}", Status::kDone,
+         {item("e", "a\"b\\c/d\n\t\r\b\f", false, 0)}, "escapes");
+
+  // int32 bounds.
+  expect("{\"value\":2147483647}", Status::kDone, {item(nullptr, nullptr, true, INT32_MAX)}, "INT32_MAX");
+  expect("{\"value\":-2147483648}", Status::kDone, {item(nullptr, nullptr, true, INT32_MIN)}, "INT32_MIN");
+  expect("{\"value\":0}", Status::kDone, {item(nullptr, nullptr, true, 0)}, "zero");
+  expect_unsupported("{\"value\":2147483648}", 0, "INT32_MAX + 1");
+  expect_unsupported("{\"value\":-2147483649}", 0, "INT32_MIN - 1");
+  expect_unsupported("{\"value\":99999999999}", 0, "11 digits");
+  expect_unsupported("{\"value\":01}", 0, "leading zero");
+  expect_unsupported("{\"value\":-}", 0, "lone minus");
+
+  // Outside the schema: fall back, reporting the items already delivered.
+  expect_unsupported("{\"value\":1.5}", 0, "float");
+  expect_unsupported("{\"value\":1e3}", 0, "exponent");
+  expect_unsupported("{\"value\":true}", 0, "literal value");
+  expect_unsupported("{\"value\":\"12\"}", 0, "string value");
+  expect_unsupported("{\"id\":\"a\\u00e9\"}", 0, "\\u escape");
+  expect_unsupported("[{\"id\":\"a\",\"value\":1},{\"id\":\"b\",\"text\":\"\\u00e9\"}]", 1, "\\u after an item");
+  expect_unsupported("{\"id\":\"a\",\"value\":1,}", 0, "trailing comma in object");
+  expect_unsupported("[{\"id\":\"a\"},{\"id\":\"b\"},]", 2, "trailing comma in array");
+  expect_unsupported("{\"id\":\"a\",\"unit\":\"V\"}", 0, "unknown key");
+  expect_unsupported("{\"id\":\"a\"} x", 1, "garbage after root");
+  expect_unsupported("[{\"cfg\":\"abc\",\"snap\":[1]}]", 0, "snapshot inside array");
+  expect_unsupported("{\"snap\":[1],\"cfg\":\"abc\"}", 0, "snap before cfg");
+  expect_unsupported("{\"id\":\"a\",\"cfg\":\"abc\",\"snap\":[1]}", 0, "event and snapshot keys");
+
+  // Strings must fit the widget buffers.
+  {
+    std::string id(LIVE_DASHBOARD_ID_MAX_LEN - 1, 'i');
+    std::string text(LIVE_DASHBOARD_TEXT_MAX_LEN - 1, 't');
+    const std::string fits = "{\"id\":\"" + id + "\",\"text\":\"" + text + "\"}";
+    expect(fits.c_str(), Status::kDone, {item(id.c_str(), text.c_str(), false, 0)}, "longest id and text");
+    const std::string long_id = "{\"id\":\"" + id + "i\"}";
+    expect_unsupported(long_id.c_str(), 0, "id too long");
+    const std::string long_text = "[{\"id\":\"a\"},{\"text\":\"" + text + "t\"}]";
+    expect_unsupported(long_text.c_str(), 1, "text too long");
+  }
+
+  // Positional snapshots: accepted ones deliver every element, rejected ones none.
+  {
+    const char *line = "{\"cfg\":\"a1b2\",\"snap\":[7,\"on\",[-2,\"-2C\"],null]}";
+    expect(line, Status::kDone,
+           {snap_begin("a1b2"), snap_item(0, nullptr, true, 7), snap_item(1, "on", false, 0),
+            snap_item(2, "-2C", true, -2), snap_item(3, nullptr, false, 0)},
+           "accepted snapshot");
+    const Result accepted = scan(line);
+    check(accepted.dispatched == 4 && accepted.applied == 4, "accepted snapshot dispatched() == 4");
+
+    Recorder reject;
+    reject.accept_snapshot = false;
+    const Result rejected = scan(line, 0, reject);
+    check(rejected.status == Status::kDone, "rejected snapshot still parses to the end");
+    check(rejected.dispatched == 0 && rejected.applied == 0, "rejected snapshot dispatched() == 0");
+    check(rejected.seen.size() == 1 && rejected.seen[0] == snap_begin("a1b2"), "rejected snapshot only sees begin");
+
+    expect("{\"cfg\":\"x\",\"snap\":[]}", Status::kDone, {snap_begin("x")}, "empty snapshot");
+    expect_unsupported("{\"cfg\":\"x\",\"snap\":[1,[2]]}", 1, "pair without text");
+    expect_unsupported("{\"cfg\":\"x\",\"snap\":[1,1.5]}", 1, "float element");
+    expect_unsupported("{\"cfg\":\"x\",\"snap\":[1,nul]}", 1, "broken null");
+  }
+
+  // dispatched() counts items handed over, applied() only those the sink took.
+  {
+    Recorder r;
+    r.reject_id = "b";
+    const Result res = scan("[{\"id\":\"a\"},{\"id\":\"b\"},{\"id\":\"c\"}]", 0, r);
+    check(res.dispatched == 3 && res.applied == 2, "dispatched() vs applied()");
+  }
+
+  // Every chunking of a line gives the same events as feeding it whole, including numbers
+  // that end exactly at a chunk boundary.
+  static const char *const kLines[] = {
+      "[{\"id\":\"cpu\",\"value\":26,\"text\":\"26%\"},{\"id\":\"voltage\",\"value\":-117,\"text\":\"a\\\"b\"}]",
+      "{\"value\":2147483647}",
+      "{\"cfg\":\"a1b2\",\"snap\":[7,\"on\",[-2,\"-2C\"],null,[0,\"\\n\"]]}",
+      "[{\"id\":\"a\",\"value\":1},{\"id\":\"b\",\"value\":1.5}]",
+  };
+  for (const char *line : kLines) {
+    const Result whole = scan(line);
+    for (size_t chunk = 1; chunk <= std::strlen(line); ++chunk) {
+      const Result part = scan(line, chunk);
+      if (part.status != whole.status || part.dispatched != whole.dispatched || part.seen != whole.seen) {
+        std::printf("FAIL: chunk size %zu differs from whole feed for %s\n", chunk, line);
+        ++g_failures;
+        break;
+      }
+    }
+  }
+
+  // begin() resets a scanner that stopped mid-line.
+  {
+    Recorder r;
+    EventScanner scanner;
+    scanner.begin(&record_sink, &r);
+    scanner.feed("{\"value\":1.", 11);
+    scanner.begin(&record_sink, &r);
+    const char *line = "{\"id\":\"z\"}";
+    check(scanner.feed(line, std::strlen(line)) == Status::kDone && scanner.dispatched() == 1,
+          "begin() after kUnsupported");
+  }
+
+  if (g_failures != 0) {
+    std::printf("event_scanner_test: %d failure(s)\n", g_failures);
+    return 1;
+  }
+  std::printf("event_scanner_test: ok\n");
+  return 0;
+}
@@ -0,0 +1,183 @@
+// Host check of the RGB565 pixel kernels against LVGL 8's software blend.
+//
+// lvgl_fill_normal() below follows lv_draw_sw_blend.c (fill_normal, no mask) and
+// lv_color.h (lv_color_mix, lv_color_premult, lv_color_mix_premult) for LV_COLOR_DEPTH 16,
+// LV_COLOR_16_SWAP 0 and LV_COLOR_MIX_ROUND_OFS 0, the settings in include/lv_conf.h.
+// Run with tools/host_tests/run.sh.
+
+#include "PixelKernels.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace ws_lcd_35_s3_hal;
+
+namespace {
+
+typedef uint8_t lv_opa_t;
+
+typedef union {
+  struct {
+    uint16_t blue : 5;
+    uint16_t green : 6;
+    uint16_t red : 5;
+  } ch;
+  uint16_t full;
+} lv_color_t;
+
+#define LV_UDIV255(x) ((uint32_t)((uint32_t)(x) * 0x8081U) >> 0x17)
+#define LV_OPA_MAX 253
+
+lv_color_t lv_color_mix(lv_color_t c1, lv_color_t c2, uint8_t mix) {
+  lv_color_t ret;
+  mix = (uint32_t)((uint32_t)mix + 4) >> 3;
+  uint32_t bg = (uint32_t)((uint32_t)c2.full | ((uint32_t)c2.full << 16)) & 0x7E0F81F;
+  uint32_t fg = (uint32_t)((uint32_t)c1.full | ((uint32_t)c1.full << 16)) & 0x7E0F81F;
+  uint32_t result = ((((fg - bg) * mix) >> 5) + bg) & 0x7E0F81F;
+  ret.full = (uint16_t)((result >> 16) | result);
+  return ret;
+}
+
+void lv_color_premult(lv_color_t c, uint8_t mix, uint16_t *out) {
+  out[0] = (uint16_t)c.ch.red * mix;
+  out[1] = (uint16_t)c.ch.green * mix;
+  out[2] = (uint16_t)c.ch.blue * mix;
+}
+
+lv_color_t lv_color_mix_premult(uint16_t *premult_c1, lv_color_t c2, uint8_t mix) {
+  lv_color_t ret;
+  ret.ch.red = LV_UDIV255(premult_c1[0] + c2.ch.red * mix);
+  ret.ch.green = LV_UDIV255(premult_c1[1] + c2.ch.green * mix);
+  ret.ch.blue = LV_UDIV255(premult_c1[2] + c2.ch.blue * mix);
+  return ret;
+}
+
+void lvgl_fill_normal(lv_color_t *dest_buf, int32_t w, int32_t h, int32_t dest_stride, lv_color_t color,
+                      lv_opa_t opa) {
+  if (opa >= LV_OPA_MAX) {
+    for (int32_t y = 0; y < h; y++) {
+      for (int32_t x = 0; x < w; x++) dest_buf[x] = color;
+      dest_buf += dest_stride;
+    }
+    return;
+  }
+  lv_color_t last_dest_color;
+  last_dest_color.full = 0;
+  lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+  opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+  opa = opa << 3;
+  uint16_t color_premult[3];
+  lv_color_premult(color, opa, color_premult);
+  lv_opa_t opa_inv = 255 - opa;
+  for (int32_t y = 0; y < h; y++) {
+    for (int32_t x = 0; x < w; x++) {
+      if (last_dest_color.full != dest_buf[x].full) {
+        last_dest_color = dest_buf[x];
+        last_res_color = lv_color_mix_premult(color_premult, dest_buf[x], opa_inv);
+      }
+      dest_buf[x] = last_res_color;
+    }
+    dest_buf += dest_stride;
+  }
+}
+
+lv_color_t to_color(uint16_t full) {
+  lv_color_t c;
+  c.full = full;
+  return c;
+}
+
+int g_failures = 0;
+
+void check(bool ok, const char *what) {
+  if (!ok) {
+    std::printf("FAIL: %s\n", what);
+    ++g_failures;
+  }
+}
+
+uint16_t blend_one(uint16_t bg, uint16_t color, uint8_t opa) {
+  blend565Ref(&bg, 1, 1, 1, color, opa);
+  return bg;
+}
+
+// Backgrounds with flat runs, black pixels (the cache's starting point) and noise.
+void fill_bg(std::vector<uint16_t> &buf, uint32_t seed) {
+  uint32_t x = seed * 2654435761U + 1U;
+  for (size_t i = 0; i < buf.size(); ++i) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    switch (i % 11) {
+      case 0:
+      case 1: buf[i] = 0x0000; break;
+      case 2:
+      case 3:
+      case 4: buf[i] = 0x18C3; break;
+      default: buf[i] = static_cast<uint16_t>(x); break;
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  // Values worked out by hand from the LVGL formulas.
+  check(blend_one(0x0000, 0xFFFF, 128) == 0x7BEF, "white 128 over black (lv_color_mix)");
+  check(blend_one(0x001F, 0xFFFF, 128) == 0x7BFF, "white 128 over blue (premult)");
+  check(blend_one(0x001F, 0xFFFF, 252) == 0x001F, "opa 252 wraps to 0 for premult");
+  check(blend_one(0x0000, 0xFFFF, 252) == 0xFFFF, "opa 252 over black keeps lv_color_mix");
+
+  // Zero-sized areas must not touch dst.
+  blend565(nullptr, 0, 0, 4, 0xFFFF, 128);
+  blend565(nullptr, 8, 8, 0, 0xFFFF, 128);
+  blend565Ref(nullptr, 0, 0, 4, 0xFFFF, 128);
+
+  // Reference against the LVGL port, every opacity the draw hook blends with, over areas of
+  // several shapes so the cache crosses rows and strides.
+  static const uint16_t kColors[] = {0x0000, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0x18C3, 0x8410, 0x1234};
+  struct Shape {
+    size_t w, h, stride;
+  };
+  static const Shape kShapes[] = {{1, 1, 1}, {7, 1, 7}, {5, 3, 9}, {33, 4, 40}, {320, 2, 320}};
+  for (const Shape &shape : kShapes) {
+    const size_t len = shape.stride * (shape.h - 1) + shape.w;
+    std::vector<uint16_t> src(len), got(len), want(len);
+    for (uint16_t color : kColors) {
+      for (unsigned opa = 3; opa < LV_OPA_MAX; ++opa) {
+        fill_bg(src, static_cast<uint32_t>(opa * 7 + color + len));
+        got = src;
+        want = src;
+        blend565Ref(got.data(), shape.stride, shape.w, shape.h, color, static_cast<uint8_t>(opa));
+        lvgl_fill_normal(reinterpret_cast<lv_color_t *>(want.data()), static_cast<int32_t>(shape.w),
+                         static_cast<int32_t>(shape.h), static_cast<int32_t>(shape.stride),
+                         to_color(color), static_cast<lv_opa_t>(opa));
+        if (got != want) {
+          std::printf("FAIL: blend565Ref != fill_normal (color=%04x opa=%u w=%zu h=%zu)\n",
+                      color, opa, shape.w, shape.h);
+          ++g_failures;
+        }
+        got = src;
+        blend565(got.data(), shape.stride, shape.w, shape.h, color, static_cast<uint8_t>(opa));
+        if (got != want) {
+          std::printf("FAIL: blend565 != fill_normal (color=%04x opa=%u w=%zu h=%zu)\n",
+                      color, opa, shape.w, shape.h);
+          ++g_failures;
+        }
+      }
+    }
+  }
+
+  // Default kernels against the references (the check the firmware runs at boot).
+  const char *failed = "pixelKernelsSelfTest";
+  const bool self_test_ok = pixelKernelsSelfTest(&failed);
+  check(self_test_ok, failed);
+
+  if (g_failures != 0) {
+    std::printf("pixel_kernels_test: %d failure(s)\n", g_failures);
+    return 1;
+  }
+  std::printf("pixel_kernels_test: ok\n");
+  return 0;
+}
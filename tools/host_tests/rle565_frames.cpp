@@ -0,0 +1,142 @@
+// Writes synthetic RGB565 frames through the firmware's RLE565 encoder for
+// rle565_roundtrip.py: for every case <dir>/<name>.r565 (encoded) and <dir>/<name>.raw (the
+// source pixels, little-endian u16, row-major). Run with tools/host_tests/run.sh.
+
+#include "Rle565.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ws_lcd_35_s3_hal;
+
+namespace {
+
+struct Frame {
+  std::string name;
+  uint16_t width;
+  uint16_t height;
+  std::vector<uint16_t> px;
+
+  Frame(const char *n, uint16_t w, uint16_t h) : name(n), width(w), height(h), px(size_t(w) * h) {}
+  uint16_t &at(size_t x, size_t y) { return px[y * width + x]; }
+};
+
+uint32_t g_rng = 0x9E3779B9U;
+
+uint16_t noise() {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 17;
+  g_rng ^= g_rng << 5;
+  return static_cast<uint16_t>(g_rng);
+}
+
+bool write_file(const std::string &path, const std::vector<uint8_t> &data) {
+  FILE *f = std::fopen(path.c_str(), "wb");
+  if (f == nullptr) {
+    return false;
+  }
+  const bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+  return std::fclose(f) == 0 && ok;
+}
+
+bool emit(const Frame &frame, const std::string &dir) {
+  std::vector<uint8_t> encoded(kRle565HeaderBytes);
+  rle565WriteHeader(encoded.data(), frame.width, frame.height);
+  // Slack past the documented bound so an encoder that overruns it is reported, not UB.
+  const size_t bound = rle565MaxRowBytes(frame.width);
+  std::vector<uint8_t> row_buf(bound * 2 + 16);
+  for (size_t y = 0; y < frame.height; ++y) {
+    const size_t n = rle565EncodeRow(&frame.px[y * frame.width], frame.width, row_buf.data());
+    if (n > bound) {
+      std::printf("FAIL: %s row %zu encoded to %zu bytes, bound %zu\n", frame.name.c_str(), y, n, bound);
+      return false;
+    }
+    encoded.insert(encoded.end(), row_buf.begin(), row_buf.begin() + n);
+  }
+  std::vector<uint8_t> raw;
+  raw.reserve(frame.px.size() * 2);
+  for (uint16_t v : frame.px) {
+    raw.push_back(static_cast<uint8_t>(v & 0xFF));
+    raw.push_back(static_cast<uint8_t>(v >> 8));
+  }
+  if (!write_file(dir + "/" + frame.name + ".r565", encoded) || !write_file(dir + "/" + frame.name + ".raw", raw)) {
+    std::printf("FAIL: cannot write %s in %s\n", frame.name.c_str(), dir.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::vector<Frame> make_frames() {
+  std::vector<Frame> frames;
+
+  // Flat screen: every row is runs of the 128-pixel maximum plus a remainder.
+  Frame flat("flat_480x320", 480, 320);
+  for (uint16_t &v : flat.px) v = 0x18C3;
+  frames.push_back(flat);
+
+  // Noise: literal packets only, split at 128 pixels.
+  Frame random("noise_321x7", 321, 7);
+  for (uint16_t &v : random.px) v = noise();
+  frames.push_back(random);
+
+  // Runs that start at x = 0 or end at the last column, and runs as long as the row, so a
+  // packet crossing a row boundary would show.
+  Frame edges("row_edges_257x9", 257, 9);
+  for (size_t y = 0; y < edges.height; ++y) {
+    for (size_t x = 0; x < edges.width; ++x) {
+      const bool head = x < 3 + y * 20;
+      const bool tail = x + 130 + y >= edges.width;
+      edges.at(x, y) = head ? 0xF800 : tail ? static_cast<uint16_t>(0x07E0 + y % 3) : noise();
+    }
+  }
+  frames.push_back(edges);
+
+  // Runs of 1, 2 and 3 (below, at and above the shortest encoded run) and literals of
+  // 127..129 pixels next to runs of 127..130.
+  Frame mixed("run_lengths_613x5", 613, 5);
+  for (size_t y = 0; y < mixed.height; ++y) {
+    size_t x = 0;
+    size_t k = y;
+    while (x < mixed.width) {
+      static const size_t kLens[] = {1, 2, 3, 127, 128, 129, 130, 2, 1};
+      const size_t len = kLens[k++ % (sizeof(kLens) / sizeof(kLens[0]))];
+      const bool literal = (k % 2) == 0;
+      const uint16_t c = noise();
+      for (size_t i = 0; i < len && x < mixed.width; ++i, ++x) {
+        mixed.at(x, y) = literal ? noise() : c;
+      }
+    }
+  }
+  frames.push_back(mixed);
+
+  // Odd and tiny widths, including the packet limit and one past it.
+  static const uint16_t kWidths[] = {1, 2, 3, 127, 128, 129, 255, 479};
+  for (uint16_t w : kWidths) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "width_%u", static_cast<unsigned>(w));
+    Frame f(name, w, 3);
+    for (size_t x = 0; x < w; ++x) {
+      f.at(x, 0) = 0xFFFF;
+      f.at(x, 1) = noise();
+      f.at(x, 2) = (x / 4) % 2 ? 0x001F : 0x0000;
+    }
+    frames.push_back(f);
+  }
+  return frames;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    std::printf("usage: %s <out_dir>\n", argv[0]);
+    return 2;
+  }
+  for (const Frame &frame : make_frames()) {
+    if (!emit(frame, argv[1])) {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""Decodes the frames written by rle565_frames.cpp with tools/screenshot_decode.py and checks
+them pixel for pixel against the source pixels.
+
+Usage:
+  tools/host_tests/rle565_roundtrip.py <dir with .r565/.raw pairs>
+"""
+
+import glob
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+
+import screenshot_decode  # noqa: E402
+
+
+def check(r565_path):
+    with open(r565_path, "rb") as f:
+        try:
+            width, height, rows = screenshot_decode.decode_rle565(f.read())
+        except (ValueError, struct.error) as e:
+            return str(e)
+    with open(os.path.splitext(r565_path)[0] + ".raw", "rb") as f:
+        raw = f.read()
+    if len(raw) != width * height * 2:
+        return "size %ux%u does not match %u source bytes" % (width, height, len(raw))
+    want = struct.unpack("<%dH" % (width * height), raw)
+    for y, row in enumerate(rows):
+        if list(row) != list(want[y * width:(y + 1) * width]):
+            x = next(i for i, (a, b) in enumerate(zip(row, want[y * width:])) if a != b)
+            return "pixel (%u,%u) differs" % (x, y)
+    return None
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        return 2
+    paths = sorted(glob.glob(os.path.join(sys.argv[1], "*.r565")))
+    if not paths:
+        print("FAIL: no .r565 files in %s" % sys.argv[1])
+        return 1
+    failures = 0
+    for path in paths:
+        error = check(path)
+        if error is not None:
+            print("FAIL: %s: %s" % (os.path.basename(path), error))
+            failures += 1
+    if failures:
+        print("rle565_roundtrip: %d of %d frame(s) failed" % (failures, len(paths)))
+        return 1
+    print("rle565_roundtrip: ok (%d frames)" % len(paths))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,48 @@
+#!/bin/sh
+# Builds and runs the host checks for the pure C++ parts of the firmware.
+# Usage: tools/host_tests/run.sh   (needs g++ and python3)
+set -e
+root=$(cd "$(dirname "$0")/../.." && pwd)
+out=${TMPDIR:-/tmp}/rovi_host_tests
+mkdir -p "$out"
+CXX=${CXX:-g++}
+CXXFLAGS="-std=gnu++17 -O2 -Wall -Wextra"
+
+$CXX $CXXFLAGS -I"$root/lib/WsLcd35S3Hal/src" \
+  "$root/tools/host_tests/pixel_kernels_test.cpp" "$root/lib/WsLcd35S3Hal/src/PixelKernels.cpp" \
+  -o "$out/pixel_kernels_test"
+"$out/pixel_kernels_test"
+
+$CXX $CXXFLAGS -I"$root/lib/WsLcd35S3Hal/src" \
+  "$root/tools/host_tests/rle565_frames.cpp" "$root/lib/WsLcd35S3Hal/src/Rle565.cpp" \
+  -o "$out/rle565_frames"
+rm -rf "$out/rle565"
+mkdir -p "$out/rle565"
+"$out/rle565_frames" "$out/rle565"
+python3 "$root/tools/host_tests/rle565_roundtrip.py" "$out/rle565"
+
+$CXX $CXXFLAGS -I"$root/lib/LiveDashboard/src" \
+  "$root/tools/host_tests/event_scanner_test.cpp" "$root/lib/LiveDashboard/src/EventScanner.cpp" \
+  -o "$out/event_scanner_test"
+"$out/event_scanner_test"
+
+# The parser bench compares against ArduinoJson when its headers are around (the PlatformIO
+# download, or ARDUINOJSON_INCLUDE=<dir with ArduinoJson.h>).
+aj_inc=${ARDUINOJSON_INCLUDE:-}
+if [ -z "$aj_inc" ]; then
+  for d in "$root"/.pio/libdeps/*/ArduinoJson/src; do
+    if [ -f "$d/ArduinoJson.h" ]; then
+      aj_inc=$d
+      break
+    fi
+  done
+fi
+$CXX $CXXFLAGS -I"$root/lib/LiveDashboard/src" ${aj_inc:+-I"$aj_inc"} \
+  "$root/tools/host_tests/event_scanner_bench.cpp" "$root/lib/LiveDashboard/src/EventScanner.cpp" \
+  -o "$out/event_scanner_bench"
+"$out/event_scanner_bench" "$root/data/test.jsonl"
+
+$CXX $CXXFLAGS -I"$root/lib/LiveDashboard/src" \
+  "$root/tools/host_tests/value_format_test.cpp" "$root/lib/LiveDashboard/src/ValueFormat.cpp" \
+  -o "$out/value_format_test"
+"$out/value_format_test"
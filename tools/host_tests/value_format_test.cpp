@@ -0,0 +1,133 @@
+// Host check of the widget value formats (lib/LiveDashboard/src/ValueFormat.h): compiling
+// scale/decimals into mul/div, rounding half away from zero, negatives and truncation.
+// Run with tools/host_tests/run.sh.
+
+#include "ValueFormat.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace live_dashboard;
+
+namespace {
+
+int g_failures = 0;
+
+void check(bool ok, const char *what) {
+  if (!ok) {
+    std::printf("FAIL: %s\n", what);
+    ++g_failures;
+  }
+}
+
+ValueFormat compile_or_fail(double scale, uint8_t decimals, const char *unit = "", const char *suffix = "") {
+  ValueFormat f;
+  if (!compileValueFormat(scale, decimals, unit, suffix, &f)) {
+    std::printf("FAIL: compileValueFormat(%g, %u) rejected\n", scale, decimals);
+    ++g_failures;
+  }
+  return f;
+}
+
+void expect(const ValueFormat &f, int32_t value, const char *want) {
+  char buf[kValueFormatMaxText];
+  const size_t len = renderValueFormat(f, value, buf, sizeof(buf));
+  if (std::strcmp(buf, want) != 0 || len != std::strlen(want)) {
+    std::printf("FAIL: %ld * %ld / %ld (%u decimals) rendered \"%s\", want \"%s\"\n", static_cast<long>(value),
+                static_cast<long>(f.mul), static_cast<long>(f.div), f.decimals, buf, want);
+    ++g_failures;
+  }
+}
+
+} // namespace
+
+int main() {
+  // The default format prints the plain value.
+  const ValueFormat plain;
+  expect(plain, 0, "0");
+  expect(plain, 42, "42");
+  expect(plain, -7, "-7");
+  expect(plain, INT32_MAX, "2147483647");
+  expect(plain, INT32_MIN, "-2147483648");
+
+  // Decimals only move the point: 0.1 with one decimal is value / 10 exactly.
+  const ValueFormat volts = compile_or_fail(0.1, 1, "V");
+  check(volts.mul == 1 && volts.div == 1, "0.1 x 1 decimal compiles to 1/1");
+  expect(volts, 126, "12.6V");
+  expect(volts, 5, "0.5V");
+  expect(volts, -5, "-0.5V");
+  expect(volts, 0, "0.0V");
+
+  // Rounding half away from zero, on both sides.
+  const ValueFormat tenth = compile_or_fail(0.1, 0);
+  check(tenth.mul == 1 && tenth.div == 10, "0.1 x 0 decimals compiles to 1/10");
+  expect(tenth, 14, "1");
+  expect(tenth, 15, "2");
+  expect(tenth, 25, "3");
+  expect(tenth, -14, "-1");
+  expect(tenth, -15, "-2");
+  expect(tenth, -25, "-3");
+  expect(tenth, -4, "0"); // rounds to zero: no "-0"
+  expect(tenth, INT32_MIN, "-214748365");
+
+  const ValueFormat cents = compile_or_fail(0.01, 1, "", " A");
+  expect(cents, 5, "0.1 A");
+  expect(cents, -5, "-0.1 A");
+  expect(cents, -4, "0.0 A");
+  expect(cents, 12345, "123.5 A");
+
+  // mul/div are reduced by their gcd.
+  const ValueFormat quarter = compile_or_fail(0.25, 0);
+  check(quarter.mul == 1 && quarter.div == 4, "0.25 reduces 25/100 to 1/4");
+  expect(quarter, 1, "0");
+  expect(quarter, 2, "1");
+  expect(quarter, -2, "-1");
+  expect(quarter, 3, "1");
+  const ValueFormat percent = compile_or_fail(0.5, 1, "%");
+  check(percent.mul == 5 && percent.div == 1, "0.5 x 1 decimal reduces 50/10 to 5/1");
+  expect(percent, 3, "1.5%");
+  const ValueFormat neg = compile_or_fail(-2.0, 0);
+  check(neg.mul == -2 && neg.div == 1, "negative scale");
+  expect(neg, 21, "-42");
+  expect(neg, -21, "42");
+  const ValueFormat fine = compile_or_fail(0.000125, 0);
+  check(fine.mul == 1 && fine.div == 8000, "0.000125 reduces to 1/8000");
+  expect(fine, 4000, "1");
+  expect(fine, -3999, "0");
+
+  // Scales that are not a ratio over 10^k (k <= 6), and other invalid specs.
+  ValueFormat untouched;
+  untouched.mul = 77;
+  ValueFormat out = untouched;
+  check(!compileValueFormat(1.0 / 3.0, 0, "", "", &out), "1/3 rejected");
+  check(!compileValueFormat(2.0 / 3.0, 2, "", "", &out), "2/3 with decimals rejected");
+  check(!compileValueFormat(1e-7, 0, "", "", &out), "1e-7 needs 10^7, rejected");
+  check(!compileValueFormat(0.0, 0, "", "", &out), "zero scale rejected");
+  check(!compileValueFormat(NAN, 0, "", "", &out), "NaN rejected");
+  check(!compileValueFormat(INFINITY, 0, "", "", &out), "infinity rejected");
+  check(!compileValueFormat(1e10, 0, "", "", &out), "mul beyond int32 rejected");
+  check(!compileValueFormat(1.0, kValueFormatMaxDecimals + 1, "", "", &out), "too many decimals rejected");
+  check(!compileValueFormat(1.0, 0, "0123456789ab", "0123456789ab", &out), "unit + suffix too long rejected");
+  check(!compileValueFormat(1.0, 0, "", "", nullptr), "null output rejected");
+  check(out.mul == 77, "rejected spec leaves the output alone");
+  check(compileValueFormat(1.0, 0, "0123456789ab", "0123456789a", &out) && out.tail_len == 23,
+        "longest unit + suffix accepted");
+
+  // Output is truncated to the buffer and always terminated.
+  {
+    char buf[4];
+    const size_t len = renderValueFormat(volts, 126, buf, sizeof(buf));
+    check(len == 3 && std::strcmp(buf, "12.") == 0, "truncated to out_size - 1");
+    check(renderValueFormat(volts, 126, buf, 0) == 0, "out_size 0 writes nothing");
+    check(renderValueFormat(volts, 126, nullptr, 8) == 0, "null out writes nothing");
+  }
+
+  if (g_failures != 0) {
+    std::printf("value_format_test: %d failure(s)\n", g_failures);
+    return 1;
+  }
+  std::printf("value_format_test: ok\n");
+  return 0;
+}
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""Convert device screenshots (.r565 / .bmp) to PNG.
+
+Usage:
+  tools/screenshot_decode.py run_3/1.r565 [more files...] [-o out_dir]
+
+Only the Python standard library is used, so it runs anywhere.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+RLE565_MAGIC = b"R565"
+RLE565_HEADER_BYTES = 12
+
+
+def rgb565_to_rgb888(v):
+    r = (v >> 11) & 0x1F
+    g = (v >> 5) & 0x3F
+    b = v & 0x1F
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)
+
+
+def decode_rle565_row(data, pos, width):
+    """Decodes one row starting at data[pos]. Returns (list of RGB565 values, new pos)."""
+    row = []
+    while len(row) < width:
+        if pos >= len(data):
+            raise ValueError("truncated RLE565 row")
+        h = data[pos]
+        pos += 1
+        n = (h & 0x7F) + 1
+        if h & 0x80:
+            (v,) = struct.unpack_from("<H", data, pos)
+            pos += 2
+            row.extend([v] * n)
+        else:
+            row.extend(struct.unpack_from("<%dH" % n, data, pos))
+            pos += 2 * n
+    if len(row) != width:
+        raise ValueError("RLE565 packet crosses row boundary")
+    return row, pos
+
+
+def decode_rle565(data):
+    """Returns (width, height, rows) where rows are lists of RGB565 values."""
+    if data[:4] != RLE565_MAGIC:
+        raise ValueError("not an RLE565 file")
+    version = data[4]
+    if version != 1:
+        raise ValueError("unsupported RLE565 version %d" % version)
+    width, height = struct.unpack_from("<HH", data, 6)
+    pos = RLE565_HEADER_BYTES
+    rows = []
+    for _ in range(height):
+        row, pos = decode_rle565_row(data, pos, width)
+        rows.append(row)
+    return width, height, rows
+
+
+def decode_bmp565(data):
+    """Decodes the 16-bit BI_BITFIELDS BMP written by WsLcd35S3Hal."""
+    if data[:2] != b"BM":
+        raise ValueError("not a BMP file")
+    offset = struct.unpack_from("<I", data, 10)[0]
+    width, height = struct.unpack_from("<ii", data, 18)
+    bpp = struct.unpack_from("<H", data, 28)[0]
+    if bpp != 16:
+        raise ValueError("unsupported BMP bit depth %d" % bpp)
+    row_padded = (width * 2 + 3) & ~3
+    rows = []
+    for y in range(abs(height)):
+        src_y = (height - 1 - y) if height > 0 else y
+        start = offset + src_y * row_padded
+        rows.append(list(struct.unpack_from("<%dH" % width, data, start)))
+    return width, abs(height), rows
+
+
+def write_png(path, width, height, rows):
+    raw = bytearray()
+    for row in rows:
+        raw.append(0)  # filter: none
+        for v in row:
+            raw.extend(rgb565_to_rgb888(v))
+
+    def chunk(tag, payload):
+        body = tag + payload
+        return struct.pack(">I", len(payload)) + body + struct.pack(">I", zlib.crc32(body) & 0xFFFFFFFF)
+
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(bytes(raw), 6)))
+        f.write(chunk(b"IEND", b""))
+
+
+def decode_file(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] == RLE565_MAGIC:
+        return decode_rle565(data)
+    return decode_bmp565(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+")
+    parser.add_argument("-o", "--out-dir", default=None, help="output directory (default: next to input)")
+    args = parser.parse_args()
+
+    for path in args.inputs:
+        width, height, rows = decode_file(path)
+        base = os.path.splitext(os.path.basename(path))[0] + ".png"
+        out_dir = args.out_dir if args.out_dir else os.path.dirname(path)
+        out = os.path.join(out_dir, base)
+        write_png(out, width, height, rows)
+        print("%s -> %s (%ux%u)" % (path, out, width, height))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Grab screenshots from a running unit over serial.
+
+Sends `!snap` and decodes the RVSF binary frame the firmware streams back
+(see lib/ScreenshotController/src/SerialFrameWriter.h), then writes PNG.
+
+Usage:
+  tools/serial_screenshot.py /dev/ttyACM0 [-n 10] [-i 0.2] [-o shots/]
+
+Uses pyserial when installed; otherwise opens the device directly (POSIX).
+Text log lines that arrive around the frame are passed through to stdout.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import screenshot_decode  # noqa: E402
+
+FRAME_MAGIC = b"RVSF"
+FORMAT_BMP = 0
+FORMAT_RLE565 = 1
+
+
+def crc16(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+class Port:
+    def __init__(self, path, baud):
+        try:
+            import serial  # type: ignore
+
+            self._ser = serial.Serial(path, baud, timeout=0.2)
+            self._fd = None
+        except ImportError:
+            import termios
+            import tty
+
+            self._ser = None
+            self._fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+            tty.setraw(self._fd)
+            attrs = termios.tcgetattr(self._fd)
+            attrs[6][termios.VMIN] = 0
+            attrs[6][termios.VTIME] = 2
+            termios.tcsetattr(self._fd, termios.TCSANOW, attrs)
+
+    def write(self, data):
+        if self._ser is not None:
+            self._ser.write(data)
+        else:
+            os.write(self._fd, data)
+
+    def read(self, n):
+        if self._ser is not None:
+            return self._ser.read(n)
+        return os.read(self._fd, n)
+
+
+class Reader:
+    def __init__(self, port, timeout_s):
+        self.port = port
+        self.buf = bytearray()
+        self.timeout_s = timeout_s
+
+    def _fill(self, deadline):
+        while time.time() < deadline:
+            data = self.port.read(4096)
+            if data:
+                self.buf.extend(data)
+                return
+        raise TimeoutError("serial read timeout")
+
+    def take(self, n, deadline):
+        while len(self.buf) < n:
+            self._fill(deadline)
+        out = bytes(self.buf[:n])
+        del self.buf[:n]
+        return out
+
+    def seek_magic(self, deadline):
+        """Drops bytes up to the frame magic, echoing complete text lines."""
+        while True:
+            idx = self.buf.find(FRAME_MAGIC)
+            if idx >= 0:
+                self._echo(self.buf[:idx])
+                del self.buf[:idx]
+                return
+            keep = len(FRAME_MAGIC) - 1
+            self._echo(self.buf[:-keep] if len(self.buf) > keep else b"")
+            del self.buf[: max(0, len(self.buf) - keep)]
+            self._fill(deadline)
+
+    @staticmethod
+    def _echo(data):
+        text = bytes(data).decode("utf-8", "replace").strip()
+        if text:
+            print(text)
+
+
+def read_frame(reader, timeout_s):
+    deadline = time.time() + timeout_s
+    reader.seek_magic(deadline)
+    header = reader.take(16, deadline)
+    if struct.unpack_from("<H", header, 14)[0] != crc16(header[:14]):
+        raise ValueError("frame header CRC mismatch")
+    _, version, fmt, width, height, seq = struct.unpack_from("<4sBBHHI", header, 0)
+    if version != 1:
+        raise ValueError("unsupported frame version %d" % version)
+
+    payload = bytearray()
+    while True:
+        (length,) = struct.unpack("<H", reader.take(2, deadline))
+        if length == 0:
+            (total,) = struct.unpack("<I", reader.take(4, deadline))
+            if total != len(payload):
+                raise ValueError("frame length mismatch (%d != %d)" % (total, len(payload)))
+            break
+        chunk = reader.take(length, deadline)
+        (crc,) = struct.unpack("<H", reader.take(2, deadline))
+        if crc != crc16(chunk):
+            raise ValueError("chunk CRC mismatch")
+        payload.extend(chunk)
+    return seq, fmt, width, height, bytes(payload)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port")
+    parser.add_argument("-b", "--baud", type=int, default=115200)
+    parser.add_argument("-n", "--count", type=int, default=1)
+    parser.add_argument("-i", "--interval", type=float, default=0.0, help="seconds between requests")
+    parser.add_argument("-o", "--out-dir", default=".")
+    parser.add_argument("-t", "--timeout", type=float, default=5.0)
+    args = parser.parse_args()
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    port = Port(args.port, args.baud)
+    reader = Reader(port, args.timeout)
+
+    start = time.time()
+    for i in range(args.count):
+        t0 = time.time()
+        port.write(b"!snap\n")
+        seq, fmt, width, height, payload = read_frame(reader, args.timeout)
+        if fmt == FORMAT_RLE565:
+            w, h, rows = screenshot_decode.decode_rle565(payload)
+        elif fmt == FORMAT_BMP:
+            w, h, rows = screenshot_decode.decode_bmp565(payload)
+        else:
+            raise ValueError("unknown frame format %d" % fmt)
+        if (w, h) != (width, height):
+            raise ValueError("frame/image size mismatch")
+        out = os.path.join(args.out_dir, "snap_%05u.png" % seq)
+        screenshot_decode.write_png(out, w, h, rows)
+        print("%s (%u bytes, %.0f ms)" % (out, len(payload), (time.time() - t0) * 1000.0))
+        if args.interval > 0 and i + 1 < args.count:
+            time.sleep(args.interval)
+
+    elapsed = time.time() - start
+    if args.count > 1 and elapsed > 0:
+        print("%.2f frames/s" % (args.count / elapsed))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
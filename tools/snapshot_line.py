@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Print the snapshot order and config hash for a dashboard config, or build a snapshot line.
+
+Usage:
+  tools/snapshot_line.py data/config.json
+  tools/snapshot_line.py data/config.json voltage=121:12.1V cpu=37 wlan=:ip:10.0.0.180
+
+A snapshot ({"cfg":"<hash>","snap":[...]}) addresses widgets by position: all `gauges`,
+then all `hz_lists` rows, in config order. The hash is 32-bit FNV-1a over "<id>\\n" for each
+position and must match the device (printed at boot as "Config hash: ...").
+Each item is `value`, `"text"`, `[value,"text"]` or null (leave unchanged).
+"""
+
+import argparse
+import json
+import sys
+
+
+def snapshot_ids(config):
+    ids = [g["id"] for g in config.get("gauges", [])]
+    for hz_list in config.get("hz_lists", []):
+        ids.extend(row["id"] for row in hz_list.get("rows", []))
+    return ids
+
+
+def config_hash(ids):
+    h = 2166136261
+    for id_ in ids:
+        for b in id_.encode("utf-8") + b"\n":
+            h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def build_line(ids, updates):
+    items = [None] * len(ids)
+    for update in updates:
+        key, _, rest = update.partition("=")
+        if key not in ids:
+            raise SystemExit("unknown id: %s" % key)
+        value, sep, text = rest.partition(":")
+        if value and sep:
+            item = [int(value), text]
+        elif value:
+            item = int(value)
+        else:
+            item = text
+        items[ids.index(key)] = item
+    while items and items[-1] is None:
+        items.pop()
+    return json.dumps({"cfg": "%08x" % config_hash(ids), "snap": items}, separators=(",", ":"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("config")
+    parser.add_argument("updates", nargs="*", help="id=value[:text] or id=:text")
+    args = parser.parse_args()
+
+    with open(args.config, "r", encoding="utf-8") as f:
+        ids = snapshot_ids(json.load(f))
+
+    if args.updates:
+        print(build_line(ids, args.updates))
+        return 0
+
+    print("cfg %08x" % config_hash(ids))
+    for i, id_ in enumerate(ids):
+        print("%3u %s" % (i, id_))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())